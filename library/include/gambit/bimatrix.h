@@ -0,0 +1,101 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/bimatrix.h
+// Dense representation of two-player strategic games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_BIMATRIX_H
+#define LIBGAMBIT_BIMATRIX_H
+
+#include <vector>
+#include "gambit.h"
+
+namespace Gambit {
+
+///
+/// The payoffs of a two-player strategic game, held as two dense
+/// matrices with rows indexed by the first player's strategies and
+/// columns by the second's.  Payoffs are exact: each player's are stored
+/// as integers over a common denominator, in the order of the
+/// contingencies of the game's table, so that a game is read in a single
+/// pass over its table.
+///
+/// Solvers for two-player games set up their matrices from this with
+/// GetScaledPayoffs(), which is instantiated for double and Rational.
+///
+class BimatrixGame {
+public:
+  /// @name Lifecycle
+  //@{
+  /// Construct from a two-player strategic game
+  explicit BimatrixGame(const Game &p_game);
+  /// Construct from the payoffs of each player, listed row by row
+  BimatrixGame(int p_rows, int p_cols,
+	       const Array<Rational> &p_payoffs1,
+	       const Array<Rational> &p_payoffs2);
+  //@}
+
+  /// @name Data access
+  //@{
+  /// Returns the number of strategies of the first player
+  int NumRows(void) const { return m_rows; }
+  /// Returns the number of strategies of the second player
+  int NumCols(void) const { return m_cols; }
+  /// Returns player pl's payoff at row i and column j
+  Rational GetPayoff(int pl, int i, int j) const;
+  /// Returns the smallest payoff, as in GameRep::GetMinPayoff()
+  const Rational &GetMinPayoff(void) const { return m_minPayoff; }
+  /// Returns the largest payoff, as in GameRep::GetMaxPayoff()
+  const Rational &GetMaxPayoff(void) const { return m_maxPayoff; }
+
+  /// Writes player pl's payoffs, transformed to
+  /// (payoff - p_shift) * p_factor, into p_matrix.  The payoff at row i
+  /// and column j goes to entry (p_row + i, p_col + j), or with
+  /// p_transpose to entry (p_row + j, p_col + i).  Floating-point
+  /// entries are the transformed payoffs rounded to double.
+  template <class T>
+  void GetScaledPayoffs(int pl, const Rational &p_shift,
+			const Rational &p_factor, Matrix<T> &p_matrix,
+			int p_row, int p_col, bool p_transpose) const;
+  //@}
+
+  /// Creates a new strategic game with these payoffs, with one outcome
+  /// per contingency
+  Game NewTable(void) const;
+
+private:
+  int m_rows, m_cols;
+  /// Numerators of each player's payoffs; when these and the
+  /// denominator are all small integers, as they usually are, they are
+  /// held in m_smallNumerators instead of m_numerators
+  bool m_isSmall[2];
+  std::vector<int64_t> m_smallNumerators[2];
+  std::vector<Integer> m_numerators[2];
+  Integer m_denominators[2];
+  Rational m_minPayoff, m_maxPayoff;
+
+  template <class P> void SetPayoffs(int pl, const P &p_payoffs);
+  template <class T> bool GetSmallScaledPayoffs(int pl, const Rational &,
+						const Rational &, Matrix<T> &,
+						int, int, bool) const;
+};
+
+} // end namespace Gambit
+
+#endif // LIBGAMBIT_BIMATRIX_H
@@ -343,6 +343,7 @@ class GameStrategyRep : public GameObject  {
   friend class TreePureStrategyProfileRep;
   friend class TablePureStrategyProfileRep;
   friend class StrategySupportProfile;
+  friend class ContingencyIterator;
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class TableMixedStrategyProfileRep;
   template <class T> friend class MixedBehaviorProfile;
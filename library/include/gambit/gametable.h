@@ -29,6 +29,7 @@ namespace Gambit {
 
 class GameTableRep : public GameExplicitRep {
   friend class StrategySupportProfile;
+  friend class BimatrixGame;
   friend class GamePlayerRep;
   friend class TablePureStrategyProfileRep;
   friend class PureStrategyProfileRep;
@@ -122,6 +123,21 @@ public:
   virtual void WriteNfgFile(std::ostream &) const;
   //@}
 
+  /// @name Direct access to the table
+  //@{
+  /// Returns the number of contingencies in the table
+  long NumContingencies(void) const { return m_results.Length(); }
+  /// Returns the payoff to player p_player at contingency p_index.
+  /// Contingencies are numbered from 1, with player 1's strategy
+  /// changing fastest, then player 2's, and so on.  This only reads
+  /// the table, so it may be called from several threads at once.
+  template <class T> T GetPayoff(long p_index, int p_player) const
+  {
+    GameOutcomeRep *outcome = m_results[p_index];
+    return (outcome) ? outcome->GetPayoff<T>(p_player) : T(0);
+  }
+  //@}
+
   virtual PureStrategyProfile NewPureStrategyProfile(void) const;
   virtual MixedStrategyProfile<double> NewMixedStrategyProfile(double) const;
   virtual MixedStrategyProfile<Rational> NewMixedStrategyProfile(const Rational &) const; 
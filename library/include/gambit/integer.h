@@ -29,6 +29,7 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 #define LIBGAMBIT_INTEGER_H
 
 #include <string>
+#include <stdint.h>
 
 namespace Gambit {
 
@@ -81,6 +82,41 @@ extern double   Itodouble(const IntegerRep*);
 extern int      Iislong(const IntegerRep*);
 extern int      Iisdouble(const IntegerRep*);
 extern long     lg(const IntegerRep*);
+extern IntegerRep*  Icopy_int64(IntegerRep*, int64_t);
+extern uint64_t Igcd64(uint64_t, uint64_t);
+
+// Small values are those with magnitude below 2^31.  The product of two
+// small values, and the sum of two such products, is exactly representable
+// in an int64_t; Rational uses this to do arithmetic on machine words
+// when it can.
+inline int Iissmall(const IntegerRep* rep)
+{
+  return (rep->len <= 1 || (rep->len == 2 && rep->s[1] < 0x8000U));
+}
+
+// Value of a rep which fits in an int64_t (in particular, a small rep)
+inline int64_t Itoint64(const IntegerRep* rep)
+{
+  uint64_t a = 0;
+  for (int i = rep->len - 1; i >= 0; --i) {
+    a = (a << 16) | rep->s[i];
+  }
+  return (rep->sgn) ? (int64_t) a : -((int64_t) a);
+}
+
+/// While an IntegerArena is alive, storage released by Integers on the
+/// current thread is kept for reuse without limit; it is returned to the
+/// system when the outermost arena on the thread is destroyed.  Solvers
+/// doing exact pivoting create one for the duration of a solve.
+class IntegerArena {
+public:
+  IntegerArena(void);
+  ~IntegerArena();
+
+private:
+  IntegerArena(const IntegerArena &);
+  IntegerArena &operator=(const IntegerArena &);
+};
 
 class Integer {
 protected:
@@ -224,6 +260,19 @@ public:
   long		  as_long() const { return Itolong(rep); }
   double	  as_double() const { return Itodouble(rep); }
 
+  // machine-word fast path; as_int64() is only meaningful if is_small()
+  int             is_small() const { return Iissmall(rep); }
+  int64_t         as_int64() const { return Itoint64(rep); }
+  void            set_int64(int64_t x) { rep = Icopy_int64(rep, x); }
+
+  /// Upper bound on the length of the decimal text of the integer,
+  /// including sign and terminating null
+  int             text_size() const;
+  /// Writes the decimal text of the integer, null-terminated, to the
+  /// buffer, which must hold text_size() characters.  Returns a pointer
+  /// to the terminating null.
+  char           *write_text(char *p_buffer) const;
+
   friend std::string Itoa(const Integer &x, int base /*= 10*/, int width /*= 0*/);
   friend Integer atoI(const char *s, int base/*= 10*/);
   
@@ -251,6 +300,9 @@ Integer  Ipow(long x, long y); // x to the y as Integer
 extern Integer  sqrt(const Integer&); // floor of square root
 extern Integer  lcm(const Integer& x, const Integer& y); // least common mult
 
+template <class D, class S> D lexical_cast(const S &p_value);
+template<> std::string lexical_cast(const Integer &);
+
 } // end namespace Gambit
 
 #endif // LIBGAMBIT_INTEGER_H
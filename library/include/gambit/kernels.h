@@ -0,0 +1,57 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/kernels.h
+// Vectorized kernels for dense floating-point linear algebra
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_KERNELS_H
+#define LIBGAMBIT_KERNELS_H
+
+namespace Gambit {
+
+///
+/// Inner loops of dense linear algebra on contiguous arrays of doubles.
+/// These do no bounds checking; callers pass pointers to the first
+/// element and the number of elements.
+///
+/// On x86 processors the implementation is chosen at runtime, using AVX2
+/// where the processor supports it and SSE2 otherwise.  All
+/// implementations perform the same floating-point operations in the
+/// same order, so results do not depend on the processor.
+///
+namespace kernels {
+
+/// Returns the inner product of x and y
+double Dot(const double *x, const double *y, int n);
+
+/// Computes y += a * x
+void Axpy(double a, const double *x, double *y, int n);
+
+/// Applies the plane rotation (c, s) to x and y, that is,
+/// (x, y) <- (c * x + s * y, -s * x + c * y)
+void Rotate(double c, double s, double *x, double *y, int n);
+
+/// Returns the name of the implementation in use
+const char *Implementation(void);
+
+} // end namespace Gambit::kernels
+
+} // end namespace Gambit
+
+#endif // LIBGAMBIT_KERNELS_H
@@ -24,52 +24,143 @@
 #define BFS_H
 
 #include "gambit/gambit.h"
-#include <map>
+#include <vector>
+#include <algorithm>
 
 namespace Gambit  {
 
 namespace linalg  {
-  
+
+//
+// A basic feasible solution is stored as the list of basic variables in
+// increasing order, with their values alongside.  Two BFSs are equal if
+// they have the same basic variables, which is then a comparison of two
+// short arrays.
+//
 template <class T> class BFS {
 private:
-  std::map<int, T> m_map;
+  std::vector<int> m_keys;
+  std::vector<T> m_values;
   T m_default;
 
+  // Position of the first basic variable not less than key
+  int Position(int key) const
+  { return std::lower_bound(m_keys.begin(), m_keys.end(), key) - m_keys.begin(); }
+
 public:
   // Lifecycle
   BFS(void) : m_default(0) { }
   ~BFS()  { }
 
   // define two BFS's to be equal if their bases are equal
-  bool operator==(const BFS &M) const {
-    if (m_map.size() != M.m_map.size())  return false;
-
-    for (typename std::map<int, T>::const_iterator iter = m_map.begin();
-	 iter != m_map.end(); iter++) {
-      if (M.m_map.count((*iter).first) == 0) {
-	return false;
-      }
-    }
-    return true;
-  }
+  bool operator==(const BFS &M) const { return m_keys == M.m_keys; }
   bool operator!=(const BFS &M) const  { return !(*this == M); }
 
   // Provide map-like operations
-  int count(int key) const { return (m_map.count(key) > 0); }
+  int count(int key) const 
+  { int i = Position(key);  return (i < (int) m_keys.size() && m_keys[i] == key); }
 
   void insert(int key, const T &value) {
-    m_map.erase(key);
-    m_map.insert(std::pair<int, T>(key, value));
+    // Tableaux report their basic variables in increasing order
+    if (m_keys.empty() || key > m_keys.back()) {
+      m_keys.push_back(key);
+      m_values.push_back(value);
+      return;
+    }
+    int i = Position(key);
+    if (m_keys[i] == key) {
+      m_values[i] = value;
+    }
+    else {
+      m_keys.insert(m_keys.begin() + i, key);
+      m_values.insert(m_values.begin() + i, value);
+    }
   }
 
   const T &operator[](int key) const {
-    if (m_map.count(key) == 1) {
-      return const_cast<std::map<int, T> &>(m_map)[key];
+    int i = Position(key);
+    if (i < (int) m_keys.size() && m_keys[i] == key) {
+      return m_values[i];
     }
     else {
       return m_default;
     }
   }
+
+  /// The basic variables, in increasing order
+  const std::vector<int> &BasicVariables(void) const { return m_keys; }
+};
+
+//
+// A set of bases, identified by their basic variables, for recording
+// which BFSs a search has already visited.  This is an open-addressing
+// hash table, so lookups take constant time on average regardless of
+// how many bases have been seen.
+//
+class BasisSet {
+private:
+  std::vector<std::vector<int> > m_keys;
+  std::vector<unsigned long> m_hashes;
+  std::vector<char> m_used;
+  int m_size;
+
+  static unsigned long Hash(const std::vector<int> &p_keys) {
+    unsigned long h = p_keys.size();
+    for (std::vector<int>::const_iterator k = p_keys.begin(); k != p_keys.end(); ++k) {
+      h ^= (unsigned long) *k + 0x9e3779b9ul + (h << 6) + (h >> 2);
+    }
+    return h;
+  }
+
+  // Slot holding p_keys, or the empty slot where it would go
+  int Find(const std::vector<int> &p_keys, unsigned long p_hash) const {
+    int mask = m_used.size() - 1;
+    int i = p_hash & mask;
+    while (m_used[i] && (m_hashes[i] != p_hash || m_keys[i] != p_keys)) {
+      i = (i + 1) & mask;
+    }
+    return i;
+  }
+
+  void Grow(void) {
+    std::vector<std::vector<int> > keys(2 * m_used.size());
+    std::vector<unsigned long> hashes(2 * m_used.size());
+    std::vector<char> used(2 * m_used.size(), 0);
+    m_keys.swap(keys);
+    m_hashes.swap(hashes);
+    m_used.swap(used);
+    for (unsigned int j = 0; j < used.size(); j++) {
+      if (used[j]) {
+	int i = Find(keys[j], hashes[j]);
+	m_keys[i].swap(keys[j]);
+	m_hashes[i] = hashes[j];
+	m_used[i] = 1;
+      }
+    }
+  }
+
+public:
+  BasisSet(void) : m_keys(16), m_hashes(16), m_used(16, 0), m_size(0) { }
+
+  int size(void) const { return m_size; }
+
+  template <class T> bool Contains(const BFS<T> &p_bfs) const {
+    const std::vector<int> &keys = p_bfs.BasicVariables();
+    return m_used[Find(keys, Hash(keys))];
+  }
+
+  /// Adds the basis of p_bfs; returns false if it was already present
+  template <class T> bool Insert(const BFS<T> &p_bfs) {
+    const std::vector<int> &keys = p_bfs.BasicVariables();
+    unsigned long hash = Hash(keys);
+    int i = Find(keys, hash);
+    if (m_used[i])  return false;
+    m_keys[i] = keys;
+    m_hashes[i] = hash;
+    m_used[i] = 1;
+    if (2 * ++m_size > (int) m_used.size())  Grow();
+    return true;
+  }
 };
 
 }  // end namespace Gambit::linalg
@@ -77,6 +168,3 @@ public:
 }  // end namespace Gambit
  
 #endif   // BFS_H
-
-
-
@@ -65,6 +65,7 @@ public:
   /// @name Raw Tableau functions
   //@{
   void Refactor(void) { T1.Refactor(); T2.Refactor(); }
+  void Detach(void) { T1.Detach(); T2.Detach(); }
   //@}
   
   /// @name Miscellaneous functions
@@ -121,6 +121,11 @@ public:
 
   // refactor 
   void refactor();
+
+  // make a copy independent of the LUdecomp it was copied from, by
+  // taking over the factors and eta matrices it would otherwise consult.
+  // Subsequent solves perform exactly the same operations as before.
+  void Detach();
   
   // solve: Bk d = a
   void solve (const Vector<T> &, Vector<T> & ) const;
@@ -0,0 +1,150 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/linalg/sparseinverse.h
+// Product form of the inverse of a basis of sparse columns
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_LINALG_SPARSEINVERSE_H
+#define GAMBIT_LINALG_SPARSEINVERSE_H
+
+#include <vector>
+#include <utility>
+#include "gambit/gambit.h"
+
+namespace Gambit {
+namespace linalg {
+
+/// A column of a sparse matrix, as a list of (row, value) pairs
+typedef std::vector<std::pair<int, double> > SparseColumn;
+
+///
+/// A dense vector with a record of the positions which have been written,
+/// so that it can be cleared, and its nonzeros visited, in time
+/// proportional to their number.  Positions are 1..n.
+///
+class SparseWork {
+public:
+  std::vector<double> m_value;
+  std::vector<char> m_used;
+  std::vector<int> m_pattern;
+
+  void Resize(int n)
+  { m_value.assign(n + 1, 0.0);  m_used.assign(n + 1, 0);  m_pattern.clear(); }
+  void Add(int i, double v)
+  {
+    if (!m_used[i]) { m_used[i] = 1;  m_pattern.push_back(i); }
+    m_value[i] += v;
+  }
+  void Set(int i, double v)
+  {
+    if (!m_used[i]) { m_used[i] = 1;  m_pattern.push_back(i); }
+    m_value[i] = v;
+  }
+  void Add(const SparseColumn &p_column, double p_scale = 1.0)
+  {
+    for (size_t k = 0; k < p_column.size(); k++) {
+      Add(p_column[k].first, p_scale * p_column[k].second);
+    }
+  }
+  void Clear(void);
+};
+
+///
+/// The inverse of a basis matrix, kept in product form as a file of
+/// sparse eta columns.  Each change of basis appends one eta column; the
+/// basis is reinverted from scratch when the file has grown enough that
+/// this is cheaper than carrying on.
+///
+/// Reinversion starts from the identity.  The slacks (unit columns) in
+/// the basis keep their own rows, and the remaining columns are brought
+/// in one at a time, sparsest first, each at the row of a departing
+/// slack which is expected to fill in least, among those with pivots of
+/// acceptable size.
+///
+class SparseInverse {
+public:
+  class SingularBasis : public Exception  {
+  public:
+    virtual ~SingularBasis() throw() { }
+    const char *what(void) const throw() { return "Singular basis in SparseInverse"; }
+  };
+
+  /// @name Lifecycle
+  //@{
+  /// Constructs the inverse of the identity matrix of order n
+  explicit SparseInverse(int n = 0);
+  //@}
+
+  /// @name General information
+  //@{
+  int NumRows(void) const { return m_size; }
+  size_t NumEtas(void) const { return m_etas.size(); }
+  size_t NumNonzeros(void) const { return m_nonzeros; }
+  /// Returns true if the basis is due to be reinverted
+  bool IsStale(void) const;
+  //@}
+
+  /// @name Solving
+  //@{
+  /// Replaces the column vector x by the solution of B x' = x
+  void Solve(SparseWork &x) const;
+  /// Replaces the row vector y by the solution of y' B = y
+  void SolveTranspose(SparseWork &y) const;
+  //@}
+
+  /// @name Changing the basis
+  //@{
+  /// Replaces the column of the basis in the row by the column a, where
+  /// p_solved is the solution of B x = a
+  void Update(int row, const SparseWork &p_solved);
+  /// Reinverts a basis.  p_slacks[i] is true if the slack for row i is
+  /// basic, in which case it is placed in row i; the other basic columns
+  /// are in p_columns.  On return, p_rows gives the row of each of these.
+  void Factor(const std::vector<char> &p_slacks,
+	      const std::vector<const SparseColumn *> &p_columns,
+	      std::vector<int> &p_rows);
+  //@}
+
+private:
+  /// An elementary matrix of the product form of the inverse: the
+  /// identity, with column m_row replaced
+  struct Eta {
+    int m_row;
+    double m_pivot;
+    std::vector<int> m_index;
+    std::vector<double> m_value;
+  };
+
+  int m_size;
+  std::vector<Eta> m_etas;
+  /// Number of nonzeros in the eta file
+  size_t m_nonzeros;
+  /// Size of the eta file after the last reinversion
+  size_t m_factorEtas, m_factorNonzeros;
+  mutable SparseWork m_work;
+
+  /// The basis is reinverted after this many updates, or sooner if the
+  /// eta file has more than doubled in size since the last reinversion
+  static const int s_refactorInterval = 100;
+};
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
+
+#endif  // GAMBIT_LINALG_SPARSEINVERSE_H
@@ -0,0 +1,128 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/linalg/sparselemke.h
+// Lemke tableau over a sparse matrix, in floating point
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_LINALG_SPARSELEMKE_H
+#define GAMBIT_LINALG_SPARSELEMKE_H
+
+#include "gambit/linalg/sparseinverse.h"
+
+namespace Gambit {
+namespace linalg {
+
+///
+/// A tableau for Lemke's algorithm, with the same pivoting rules as the
+/// SF_ functions of LemkeTableau<double>, for problems whose matrix is
+/// too large to hold densely.
+///
+/// The LCP has rows 1..n.  Column 0 is the covering vector, columns
+/// 1..n are the columns of the matrix, and the slack for row i is
+/// column -i, a unit vector.  The inverse of the basis is kept as a
+/// SparseInverse.  Reinversion may move structural variables to other
+/// rows, so rows should be looked up with Find() after pivoting.
+///
+class SparseLemkeTableau {
+public:
+  class BadPivot : public Exception  {
+  public:
+    virtual ~BadPivot() throw() { }
+    const char *what(void) const throw() { return "Bad pivot in SparseLemkeTableau"; }
+  };
+  class BadExitIndex : public Exception  {
+  public:
+    virtual ~BadExitIndex() throw() { }
+    const char *what(void) const throw() { return "Bad exit index in SparseLemkeTableau"; }
+  };
+
+  /// @name Lifecycle
+  //@{
+  /// Constructs the tableau at the basis of all slacks.  p_columns holds
+  /// columns 1..n of the matrix (entry 0 is unused), and is not copied,
+  /// so it must outlive the tableau and any copies of it.
+  SparseLemkeTableau(const std::vector<SparseColumn> &p_columns,
+		     const Vector<double> &p_covering,
+		     const Vector<double> &p_b);
+  //@}
+
+  /// @name General information
+  //@{
+  int MinRow(void) const { return 1; }
+  int MaxRow(void) const { return m_size; }
+  int MinCol(void) const { return 0; }
+  int MaxCol(void) const { return m_size; }
+  double Epsilon(void) const { return m_eps; }
+  long NumPivots(void) const { return m_numPivots; }
+
+  bool Member(int label) const { return m_row[label + m_size] != 0; }
+  /// Return variable in i'th position of tableau
+  int Label(int row) const { return m_label[row]; }
+  /// Return tableau position of variable, or zero if it is not basic
+  int Find(int label) const { return m_row[label + m_size]; }
+  /// Return the values of the basic variables, by row
+  void BasisVector(Vector<double> &) const;
+  //@}
+
+  /// @name Changing the problem
+  //@{
+  /// Sets the entry of the covering vector in the row; the tableau must
+  /// then be refactored before pivoting again
+  void SetCovering(int row, double value)
+  { m_covering[row - 1].second = value; }
+  //@}
+
+  /// @name Pivoting operations
+  //@{
+  /// Perform a pivot operation -- outgoing is row, incoming is column
+  void Pivot(int outrow, int inlabel);
+  /// Reinvert the current basis
+  void Refactor(void);
+
+  int SF_PivotIn(int inlabel);
+  int SF_ExitIndex(int inlabel);
+  /// Follow a path of ACBFS's from one CBFS to another
+  int SF_LCPPath(int dup);
+  //@}
+
+private:
+  int m_size;
+  const std::vector<SparseColumn> *m_columns;
+  /// The covering vector, with an entry for every row
+  SparseColumn m_covering;
+  std::vector<double> m_b;
+  double m_eps;
+  long m_numPivots;
+
+  // Labels of the variable basic in each row, and rows of basic labels,
+  // indexed by label + m_size
+  std::vector<int> m_label, m_row;
+  SparseInverse m_inverse;
+  std::vector<double> m_solution;
+  mutable SparseWork m_incol, m_col;
+
+  void Solve(int label, SparseWork &) const;
+  void SolveRow(int row, SparseWork &) const;
+  void SolveBasis(void);
+};
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
+
+#endif  // GAMBIT_LINALG_SPARSELEMKE_H
@@ -0,0 +1,135 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/linalg/sparselp.h
+// Revised simplex method for sparse linear programs, in floating point
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_LINALG_SPARSELP_H
+#define GAMBIT_LINALG_SPARSELP_H
+
+#include "gambit/linalg/sparseinverse.h"
+
+namespace Gambit {
+namespace linalg {
+
+///
+/// This class implements a LP solver for problems with sparse constraint
+/// matrices, in floating point.  As with LPSolve, its constructor takes
+/// as input a LP problem of the form maximize c x subject to A x <= b,
+/// x >= 0, where the last nequals rows hold with equality, and solves it.
+///
+/// The solver uses the revised simplex method, with the inverse of the
+/// basis kept as a SparseInverse.  Each variable has a lower and an
+/// upper bound, and a nonbasic variable is at one or the other; the
+/// slacks of equality rows are fixed at zero.  Rows whose slacks would
+/// start out infeasible are given artificial variables, whose sum is
+/// minimized in a first phase, after which they are fixed at zero.
+/// Entering variables are chosen by Devex pricing, switching to Bland's
+/// rule while a run of degenerate pivots lasts, so the method cannot
+/// cycle.
+///
+/// The problem may then be changed, by its right-hand side, costs, or
+/// columns, and solved again by Resolve(), which starts from the last
+/// optimal basis.  If that basis is still feasible, the primal simplex
+/// method continues from it.  Otherwise, the dual simplex method first
+/// restores feasibility, with the costs of any nonbasic variables whose
+/// reduced costs have the wrong sign shifted so that the basis is
+/// optimal to start with.
+///
+class SparseLPSolve {
+public:
+  /// @name Lifecycle
+  //@{
+  /// p_columns holds the columns 1..n of A (entry 0 is unused)
+  SparseLPSolve(const std::vector<SparseColumn> &p_columns,
+		const Vector<double> &b, const Vector<double> &c,
+		int nequals);
+  //@}
+
+  /// @name Changing the problem
+  //@{
+  /// Changes take effect at the next call to Resolve()
+  void SetRHS(int i, double p_value) { m_b[i] = p_value; }
+  void SetCost(int j, double p_value) { m_c[j] = p_value; }
+  void SetColumn(int j, const SparseColumn &p_column) { m_columns[j] = p_column; }
+  /// Solves the problem as changed, starting from the last optimal basis
+  void Resolve(void);
+  //@}
+
+  /// @name Results
+  //@{
+  double OptimumCost(void) const { return m_cost; }
+  /// Returns the values of the variables, indexed by the columns of A
+  const Vector<double> &OptimumVector(void) const { return m_primal; }
+  /// Returns the values of the dual variables, indexed by the rows of A
+  const Vector<double> &DualVector(void) const { return m_dual; }
+
+  bool IsFeasible(void) const { return m_feasible; }
+  bool IsBounded(void) const  { return m_bounded; }
+  /// Returns the number of pivots made by the most recent solve
+  long NumPivots(void) const { return m_numPivots; }
+  //@}
+
+private:
+  enum Status { BASIC, AT_LOWER, AT_UPPER };
+
+  std::vector<SparseColumn> m_columns;
+  int m_rows, m_structural, m_variables, m_equalities;
+  std::vector<double> m_b, m_c;
+  /// Variables are the columns of A, then the slacks of the rows, then
+  /// the artificials, whose columns are held in m_artificials
+  std::vector<SparseColumn> m_artificials;
+  std::vector<double> m_lower, m_upper, m_x, m_weights;
+  std::vector<Status> m_status;
+  std::vector<int> m_head;
+  SparseInverse m_inverse;
+  std::vector<double> m_y;
+  mutable SparseWork m_work, m_row;
+  double m_eps, m_pivotTol;
+
+  /// True if the basis was optimal at the end of the last solve
+  bool m_optimal;
+  bool m_feasible, m_bounded;
+  long m_numPivots;
+  double m_cost;
+  Vector<double> m_primal, m_dual;
+
+  const SparseColumn *Column(int j) const;
+  void AddColumn(int j, double scale, SparseWork &) const;
+  double DotColumn(int j, const std::vector<double> &) const;
+
+  void Solve(void);
+  void Finish(const std::vector<double> &p_cost);
+  void GetCost(std::vector<double> &) const;
+  bool IsPrimalFeasible(void) const;
+  void ShiftCost(std::vector<double> &p_cost);
+
+  void Refactor(void);
+  void ComputePrimal(void);
+  void ComputeDual(const std::vector<double> &p_cost);
+  int Price(const std::vector<double> &p_cost, bool p_bland) const;
+  bool Optimize(const std::vector<double> &p_cost);
+  bool DualOptimize(const std::vector<double> &p_cost);
+  void UpdateWeights(int p_entering, int p_row);
+};
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
+
+#endif  // GAMBIT_LINALG_SPARSELP_H
@@ -23,6 +23,7 @@
 #ifndef TABLEAU_H  
 #define TABLEAU_H
 
+#include <vector>
 #include "gambit/linalg/btableau.h"
 #include "gambit/linalg/ludecomp.h"
 
@@ -63,6 +64,9 @@ public:
 
   void Refactor();
   void SetRefactor(int);
+  // A copy shares the factorization of the original; this detaches it,
+  // so that the two can be used independently (e.g., on other threads)
+  void Detach();
 
   void SetConst(const Vector<double> &bnew);
   void SetBasis( const Basis &); // set new Tableau
@@ -89,9 +93,23 @@ private:
   Integer totdenom;  // This carries the denominator for Q data or 1 for Z
   Integer denom;  // This is the denominator for the simplex
 
+  // While denom and every entry of Tabdat and Coeff are small (in the
+  // sense of Integer::is_small()), they are held in machine words here
+  // instead, row by row, and Tabdat and Coeff are not kept up to date.
+  // Pivoting is then exact in int64_t arithmetic.
+  bool m_small;
+  std::vector<int64_t> m_smallTab, m_smallCoeff;
+  int64_t m_smallDenom;
+
   mutable Vector<Rational> tmpcol; // temporary column vector, to avoid allocation
 
   void MySolveColumn(int, Vector<Rational> &);  // column in new basis 
+  int64_t &SmallEntry(int i, int j)
+  { return m_smallTab[(i - Tabdat.MinRow()) * Tabdat.NumColumns() + (j - Tabdat.MinCol())]; }
+  void GetTabColumn(int col, Vector<Rational> &) const;
+  void Narrow();  // switches to machine words if all entries are small
+  void Widen();   // switches back to Integers
+  void SmallPivot(int row, int col);
 
 protected:
   Array<int> nonbasic;     //** nonbasic variables -- should be moved to Basis
@@ -121,6 +139,8 @@ public:
 
   void Refactor();
   void SetRefactor(int);
+  // Copies share nothing with the original, so this has no effect
+  void Detach() { }
 
   void SetConst(const Vector<Rational> &bnew);
   void SetBasis( const Basis &); // set new Tableau
@@ -42,9 +42,17 @@ namespace linalg {
 // The code is based on the reverse Pivoting algorithm of Avis 
 // and Fukuda, Discrete Computational Geom (1992) 8:295-313.
 //
+// With more than one thread, the subtrees below each node of the
+// search tree shallower than the split depth are searched as separate
+// tasks, in the manner of mplrs.  The vertices found are merged in the
+// order of the serial search, so results do not depend on the number
+// of threads or on scheduling.  If the enumerator is created inside an
+// OpenMP parallel region, its tasks run on the threads of that region.
+//
 template <class T> class VertexEnumerator {
 private:
   int mult_opt,depth;
+  int m_numThreads, m_splitDepth;
   int n;  // N is the number of columns, which is the # of dimensions.
   int k;  // K is the number of inequalities given.
   const Matrix<T> &A;   
@@ -56,14 +64,20 @@ private:
   long npivots, nodes;
   Gambit::List<long> visits,branches;
 
+  // Creates an enumerator for one branch of p_parent's search
+  VertexEnumerator(const VertexEnumerator<T> &p_parent, int p_depth);
+
   void Enum(void);
   void Deeper(void);
   void Report(void);
-  void Search(LPTableau<T> &tab);
+  void Search(LPTableau<T> &tab, int level);
+  void SearchBranches(LPTableau<T> &tab, 
+		      const Gambit::List<Array<int> > &pivots, int level);
   void DualSearch(LPTableau<T> &tab);
 
 public:
-  VertexEnumerator(const Matrix<T> &, const Vector<T> &);
+  VertexEnumerator(const Matrix<T> &, const Vector<T> &, 
+		   int p_numThreads = 1, int p_splitDepth = 2);
   VertexEnumerator(LPTableau<T> &);
   ~VertexEnumerator() { }
   
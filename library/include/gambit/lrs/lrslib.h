@@ -205,6 +205,8 @@ typedef struct lrs_dat			/* global problem data   */
 
 	/* Variables for cacheing dictionaries, db */
 	lrs_dic *Qhead, *Qtail;
+	unsigned long dict_count, dict_limit;	/* size and limit of the cache */
+	unsigned long cache_tries, cache_misses;
 
 }lrs_dat, lrs_dat_p;
 
@@ -225,7 +227,7 @@ void plrs_readlinearity(lrs_dat *Q, string line);
 /*******************************/
 /* functions  for external use */
 /*******************************/
-extern FILE *lrs_cfp;			/* output file for checkpoint information       */
+extern LRS_THREAD_LOCAL FILE *lrs_cfp;			/* output file for checkpoint information       */
 long lrs_main (int argc, char *argv[]);    /* lrs driver, argv[1]=input file, [argc-1]=output file */
 long redund_main (int argc, char *argv[]); /* redund driver, argv[1]=input file, [2]=output file */
 lrs_dat *lrs_alloc_dat (const char *name);	/* allocate for lrs_dat structure "name"       */
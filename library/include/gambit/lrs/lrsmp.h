@@ -128,11 +128,22 @@ using namespace std;
 #define CALLOC(n,s) xcalloc(n,s,__LINE__,__FILE__)
 
 
-extern long lrs_digits;		/* max permitted no. of digits   */
-extern long lrs_record_digits;		/* this is the biggest acheived so far.     */
+/* The library state below is kept per thread, so that separate     */
+/* problems can be solved concurrently on different threads.        */
+/* Each thread must call lrs_init (or lrs_mp_init) before use.      */
+#if defined(__GNUC__)
+#define LRS_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define LRS_THREAD_LOCAL __declspec(thread)
+#else
+#define LRS_THREAD_LOCAL
+#endif
+
+extern LRS_THREAD_LOCAL long lrs_digits;		/* max permitted no. of digits   */
+extern LRS_THREAD_LOCAL long lrs_record_digits;		/* this is the biggest acheived so far.     */
 
-extern FILE* lrs_ifp;			/* input file pointer       */
-extern FILE* lrs_ofp;			/* output file pointer      */
+extern LRS_THREAD_LOCAL FILE* lrs_ifp;			/* input file pointer       */
+extern LRS_THREAD_LOCAL FILE* lrs_ofp;			/* output file pointer      */
 
 
 /*************/
@@ -103,6 +103,12 @@ public:
 template <class T> 
 Vector<T> operator*(const Vector<T> &, const Matrix<T> &);
 
+// Matrices of doubles use the vectorized kernels in kernels.h
+template<> void Matrix<double>::CMultiply(const Vector<double> &,
+					  Vector<double> &) const;
+template<> void Matrix<double>::RMultiply(const Vector<double> &,
+					  Vector<double> &) const;
+
 } // end namespace Gambit
 
 #endif  // LIBGAMBIT_MATRIX_H
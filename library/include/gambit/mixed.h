@@ -224,6 +224,12 @@ public:
 
   /// Converts the profile to one on the unrestricted parent of the game
   MixedStrategyProfile<T> Unrestrict(void) const;
+
+  /// Converts the profile to one on a restriction of the game, rescaling
+  /// each player's remaining probabilities to sum to one (or to equal
+  /// probabilities, if none remains).  A profile on the game itself is
+  /// returned unchanged.
+  MixedStrategyProfile<T> Restrict(const Game &p_restriction) const;
   //@}
 
   /// @name Computation of interesting quantities
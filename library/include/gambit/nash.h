@@ -77,6 +77,7 @@ public:
 private:
   std::ostream &m_stream;
   int m_numDecimals;
+  mutable std::string m_buffer;
 };
 
 template <class T>
@@ -93,6 +94,27 @@ private:
   int m_numDecimals;
 };
 
+//
+// Renders profiles computed on a restriction of a game as profiles on
+// the game from which it was restricted, by passing them on to another
+// renderer.  Profiles on games which are not restrictions pass through.
+//
+template <class T>
+class RestrictedStrategyRenderer : public StrategyProfileRenderer<T> {
+public:
+  RestrictedStrategyRenderer(shared_ptr<StrategyProfileRenderer<T> > p_renderer)
+    : m_renderer(p_renderer) { }
+  virtual ~RestrictedStrategyRenderer() { }
+  virtual void Render(const MixedStrategyProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const;
+  virtual void Render(const MixedBehaviorProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  { m_renderer->Render(p_profile, p_label); }
+
+private:
+  shared_ptr<StrategyProfileRenderer<T> > m_renderer;
+};
+
 //
 // Encapsulates the rendering of a behavior profile to various text formats.
 //
@@ -126,6 +148,7 @@ public:
 private:
   std::ostream &m_stream;
   int m_numDecimals;
+  mutable std::string m_buffer;
 };
 
 template <class T>
@@ -205,6 +228,15 @@ private:
 		     List<GameOutcome> &values) const;
 };
 
+//
+// Returns the restriction of the game to the strategies which survive
+// iterated elimination of strategies strictly dominated by mixed
+// strategies.  Every Nash equilibrium of the game is an equilibrium of
+// the restriction, and vice versa.  If no strategy is dominated, the
+// game itself is returned.
+//
+Game UndominatedRestriction(const Game &p_game, int p_numThreads = 1);
+
 //
 // Exception raised when maximum number of equilibria to compute
 // has been reached.  A convenience for unraveling a potentially
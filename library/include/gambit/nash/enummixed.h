@@ -37,13 +37,29 @@ template <class T> class EnumMixedStrategySolver;
 template <class T> class EnumMixedStrategySolution {
   friend class EnumMixedStrategySolver<T>;
 public:
-  EnumMixedStrategySolution(const Game &p_game) : m_game(p_game) { }
+  EnumMixedStrategySolution(const Game &p_game) 
+    : m_game(p_game), m_numThreads(1), m_haveCliques(false) { }
   ~EnumMixedStrategySolution()  { }
 
   const Game &GetGame(void) const { return m_game; }
   const List<MixedStrategyProfile<T> > &GetExtremeEquilibria(void) const
   { return m_extremeEquilibria; }
-  
+
+  /// The maximal cliques of extreme equilibria, each the product of a
+  /// set of extreme strategies of player 1 and one of player 2.  Every
+  /// profile in the convex hull of a clique is an equilibrium.  The
+  /// cliques are found on first use.
+  ///@{
+  int NumCliques(void) const;
+  /// The indices of the extreme strategies of p_player in the clique
+  const Array<int> &GetClique(int p_clique, int p_player) const;
+  /// The profile made up of extreme strategies p_index1 of player 1 and
+  /// p_index2 of player 2
+  MixedStrategyProfile<T> GetExtremeProfile(int p_index1, int p_index2) const;
+  ///@}
+
+  /// Lists the profiles of each clique.  For large games, prefer
+  /// generating these one at a time via GetExtremeProfile().
   List<List<MixedStrategyProfile<T> > > GetCliques(void) const;
 
 private:
@@ -57,16 +73,28 @@ private:
   int m_v1, m_v2;
   ///@}
 
+  /// Number of threads to use for finding the cliques
+  int m_numThreads;
+
   /// Representation of the connectedness of the extreme equilibria
   /// These are generated only on demand
-  mutable List<Array<int> > m_cliques1, m_cliques2;
+  ///@{
+  mutable bool m_haveCliques;
+  mutable Array<Array<int> > m_cliques1, m_cliques2;
+  ///@}
+
+  void FindCliques(void) const;
 };
 
 
 template <class T> class EnumMixedStrategySolver : public StrategySolver<T> {
 public:
-  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
-    : StrategySolver<T>(p_onEquilibrium) {}
+  /// Vertex enumeration uses p_numThreads threads, splitting the search
+  /// trees into separate tasks down to p_splitDepth levels
+  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			  int p_numThreads = 1, int p_splitDepth = 2)
+    : StrategySolver<T>(p_onEquilibrium),
+      m_numThreads(p_numThreads), m_splitDepth(p_splitDepth) {}
   virtual ~EnumMixedStrategySolver() { }
 
   shared_ptr<EnumMixedStrategySolution<T> > SolveDetailed(const Game &p_game) const;
@@ -75,6 +103,8 @@ public:
   
   
 private:
+  int m_numThreads, m_splitDepth;
+
   /// Implement fuzzy equality for floating-point version when testing Nashness
   static bool EqZero(const T &x);
 };
@@ -84,15 +114,21 @@ private:
  
 //
 // Enumerate all mixed-strategy Nash equilibria of a two-player game
-// using the lrslib backend.
+// using the lrslib backend.  With several threads, the searches of
+// player 2's polytope for the vertices of player 1's are run
+// concurrently.
 //
 class EnumMixedLrsStrategySolver : public StrategySolver<Rational> {
 public:
-  EnumMixedLrsStrategySolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0)
-    : StrategySolver<Rational>(p_onEquilibrium) { }
+  EnumMixedLrsStrategySolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0,
+			     int p_numThreads = 1)
+    : StrategySolver<Rational>(p_onEquilibrium), m_numThreads(p_numThreads) { }
   virtual ~EnumMixedLrsStrategySolver() { }
 
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
+
+private:
+  int m_numThreads;
 };
 
 }  // end namespace Gambit::Nash
@@ -34,29 +34,18 @@ namespace Nash {
 /// 
 class EnumPureStrategySolver : public StrategySolver<Rational> {
 public:
-   EnumPureStrategySolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0) 
-    : StrategySolver<Rational>(p_onEquilibrium) { }
+  /// For games in strategic form, the payoff table is scanned using
+  /// up to p_numThreads threads
+  EnumPureStrategySolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0,
+			 int p_numThreads = 1) 
+    : StrategySolver<Rational>(p_onEquilibrium), m_numThreads(p_numThreads) { }
   virtual ~EnumPureStrategySolver()  { }
 
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
-};
 
-inline List<MixedStrategyProfile<Rational> >
-EnumPureStrategySolver::Solve(const Game &p_game) const
-{
-  if (!p_game->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
-  }
-  List<MixedStrategyProfile<Rational> > solutions;
-  for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
-    if ((*citer)->IsNash()) {
-      MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
-      m_onEquilibrium->Render(profile);
-      solutions.Append(profile);
-    }
-  }
-  return solutions;
-}
+private:
+  int m_numThreads;
+};
 
 ///
 /// Enumerate pure-strategy agent Nash equilibria of a game.  This uses
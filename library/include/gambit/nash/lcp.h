@@ -23,6 +23,7 @@
 #ifndef GAMBIT_NASH_LCP_H
 #define GAMBIT_NASH_LCP_H
 
+#include <vector>
 #include "gambit/nash.h"
 
 namespace Gambit {
@@ -30,6 +31,7 @@ namespace Gambit {
 namespace linalg {
 template <class T> class LHTableau;
 template <class T> class LemkeTableau;
+template <class T> class BFS;
 }
 
 namespace Nash {
@@ -37,23 +39,58 @@ namespace Nash {
 template <class T> class NashLcpStrategySolver : public StrategySolver<T> {
 public:
   NashLcpStrategySolver(int p_stopAfter, int p_maxDepth,
-			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			int p_numThreads = 1)
     : StrategySolver<T>(p_onEquilibrium),
-      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth),
+      m_numThreads(p_numThreads) { }
   virtual ~NashLcpStrategySolver()  { }
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const;
 
 private:
-  int m_stopAfter, m_maxDepth;
+  int m_stopAfter, m_maxDepth, m_numThreads;
 
   class Solution;
 
   bool OnBFS(const Game &, linalg::LHTableau<T> &, Solution &) const;
   void AllLemke(const Game &, int j, linalg::LHTableau<T> &, Solution &, int) const;
+  void ParallelLemke(const Game *, int j, linalg::LHTableau<T> *, 
+		     Solution *, int) const;
+};
+
+
+///
+/// Lemke-Howson for two-player strategic games, pivoting in floating
+/// point but reporting exact equilibria.  Each complementary basis
+/// reached is certified by solving for it in exact arithmetic and
+/// checking that it is feasible.  If a basis fails the check, or
+/// floating-point pivoting breaks down, the path is followed again with
+/// exact pivoting from the last certified basis, and the search below
+/// it continues exactly.
+///
+class NashLcpHybridStrategySolver : public StrategySolver<Rational> {
+public:
+  NashLcpHybridStrategySolver(int p_stopAfter, int p_maxDepth,
+			      Gambit::shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0)
+    : StrategySolver<Rational>(p_onEquilibrium),
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+  virtual ~NashLcpHybridStrategySolver()  { }
+
+  virtual List<MixedStrategyProfile<Rational> > Solve(const Game &) const;
+
+private:
+  int m_stopAfter, m_maxDepth;
+
+  class Solution;
+
+  bool OnBFS(const Game &, const linalg::BFS<Rational> &, Solution &) const;
+  void AllLemke(const Game &, int j, linalg::LHTableau<double> &,
+		const std::vector<int> &, Solution &, int) const;
+  void ExactLemke(const Game &, int j, linalg::LHTableau<Rational> &,
+		  Solution &, int) const;
 };
 
- 
 template <class T> class NashLcpBehaviorSolver : public BehavSolver<T> {
 public:
   NashLcpBehaviorSolver(int p_stopAfter, int p_maxDepth,
@@ -69,11 +106,16 @@ private:
 
   class Solution;
 
-  void FillTableau(const BehaviorSupportProfile &, Matrix<T> &, const GameNode &, T,
-		   int, int, int, int, Solution &) const;
-  void AllLemke(const BehaviorSupportProfile &, int dup, Gambit::linalg::LemkeTableau<T> &B,
-	       int depth, Matrix<T> &, Solution &) const; 
-  void GetProfile(const BehaviorSupportProfile &, const Gambit::linalg::LemkeTableau<T> &tab, 
+  void FillTableau(const BehaviorSupportProfile &, const GameNode &, T,
+		   int, int, Solution &) const;
+  void SolveLcp(const BehaviorSupportProfile &, Solution &) const;
+  template <class Tab>
+  void SolveTableau(const BehaviorSupportProfile &, Tab &, Solution &) const;
+  template <class Tab>
+  void AllLemke(const BehaviorSupportProfile &, int dup, Tab &B,
+		int depth, Solution &) const; 
+  template <class Tab>
+  void GetProfile(const BehaviorSupportProfile &, const Tab &tab, 
 		  MixedBehaviorProfile<T> &, const Vector<T> &, 
 		  const GameNode &n, int, int,
 		  Solution &) const;
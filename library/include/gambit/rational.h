@@ -96,6 +96,14 @@ public:
   friend Integer   trunc(const Rational& x);
   friend Integer   round(const Rational& x);
 
+  /// Upper bound on the length of the text of the rational, including
+  /// the terminating null
+  int              text_size() const;
+  /// Writes the text of the rational (as "num" or "num/den") to the
+  /// buffer, which must hold text_size() characters.  Returns a pointer
+  /// to the terminating null.
+  char            *write_text(char *p_buffer) const;
+
   friend std::istream &operator>>(std::istream &s, Rational& y);
   friend std::ostream &operator<<(std::ostream &s, const Rational& y);
 
@@ -117,6 +125,8 @@ public:
 
 // Naming compatible with Boost's lexical_cast concept for potential future compatibility.
 template<> Rational lexical_cast(const std::string &);
+template<> std::string lexical_cast(const Rational &);
+template<> std::string lexical_cast(const Rational &, int);
 
 } // end namespace Gambit
 
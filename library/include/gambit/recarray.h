@@ -59,6 +59,11 @@ public:
   //@{
   T &operator()(int r, int c);
   const T &operator()(int r, int c) const;
+  /// Returns a pointer to the storage of row r, which is contiguous
+  /// starting from column MinCol(); the row index is checked, but
+  /// accesses through the pointer are not
+  T *RowData(int r);
+  const T *RowData(int r) const;
   //@}
 
   /// @name Row and column rotation operators
@@ -237,6 +242,20 @@ template <class T> const T &RectArray<T>::operator()(int r, int c) const
   return data[r][c];
 }
 
+template <class T> T *RectArray<T>::RowData(int r)
+{
+  if (!CheckRow(r))  throw IndexException();
+
+  return data[r] + mincol;
+}
+
+template <class T> const T *RectArray<T>::RowData(int r) const
+{
+  if (!CheckRow(r))  throw IndexException();
+
+  return data[r] + mincol;
+}
+
 //------------------------------------------------------------------------
 //                   RectArray<T>: Row and column rotation
 //------------------------------------------------------------------------
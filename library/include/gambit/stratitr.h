@@ -75,6 +75,106 @@ public:
   //@}
 };
 
+/// This class iterates through a range of the contingencies in the
+/// table of a strategic game, working with plain indices rather than
+/// strategy profiles.  Each strategy of each player has an offset, and
+/// the index of a contingency in the table is one plus the sum of the
+/// offsets of its strategies.  Contingencies are visited with player
+/// 1's strategy changing fastest; the range to visit is given by the
+/// positions of its first and one-past-last contingencies in this order,
+/// counting from 1, so that a table can be split into separate ranges.
+///
+/// As it does not refer to the game, an iterator may be used on any
+/// thread.  The indices are those of GameTableRep::GetPayoff().
+class ContingencyIterator {
+public:
+  /// The offsets of each player's strategies
+  typedef Array<Array<long> > Offsets;
+
+  /// @name Lifecycle
+  //@{
+  /// Construct an iterator over all the contingencies
+  explicit ContingencyIterator(const Offsets &);
+  /// Construct an iterator over contingencies p_begin to p_end - 1
+  ContingencyIterator(const Offsets &, long p_begin, long p_end);
+  //@}
+
+  /// @name Offsets
+  //@{
+  /// Offsets of all strategies in a table with the given dimensions
+  static Offsets TableOffsets(const Array<int> &p_dim);
+  /// Offsets of the strategies in the support, which must be in a
+  /// game with a table
+  static Offsets SupportOffsets(const StrategySupportProfile &);
+  /// Offsets of the strategies in the support, except that p_player
+  /// has a single strategy with offset zero.  Each contingency then
+  /// stands for the line of the table on which only p_player's strategy
+  /// varies; adding a strategy's offset gives the index on the line.
+  static Offsets SupportOffsets(const StrategySupportProfile &, int p_player);
+  /// Returns the number of contingencies
+  static long NumContingencies(const Offsets &);
+  //@}
+
+  /// @name Iteration and data access
+  //@{
+  /// Advance to the next contingency (prefix version)
+  void operator++(void);
+  /// Advance to the next contingency (postfix version)
+  void operator++(int) { ++(*this); }
+  /// Has iterator gone past the end?
+  bool AtEnd(void) const { return m_position >= m_end; }
+
+  /// Returns the index in the table of the current contingency
+  long GetIndex(void) const { return m_index; }
+  /// Returns the position of the current contingency in the iteration
+  long GetPosition(void) const { return m_position; }
+  /// Returns the number of player pl's strategy in the current contingency
+  int GetStrategy(int pl) const { return m_strategy[pl]; }
+  //@}
+
+private:
+  Offsets m_offsets;
+  Array<int> m_strategy;
+  long m_index, m_position, m_end;
+
+  void Seek(long p_position);
+};
+
+/// Divides the contingencies with the given offsets into p_numRanges
+/// consecutive ranges of about equal size, and calls
+/// p_body(range, iterator) with an iterator over each range, with the
+/// ranges numbered from 1.  The ranges are shared out among up to
+/// p_numThreads threads, so p_body must be safe to call concurrently for
+/// different ranges; a caller collecting results keeps one per range
+/// and combines them in order afterwards.
+template <class Body>
+void ForEachContingencyRange(const ContingencyIterator::Offsets &p_offsets,
+			     int p_numRanges, int p_numThreads, Body &p_body)
+{
+  long size = ContingencyIterator::NumContingencies(p_offsets);
+  std::string error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(p_numThreads) if (p_numThreads > 1 && p_numRanges > 1)
+#endif  // _OPENMP
+  for (int range = 1; range <= p_numRanges; range++) {
+    try {
+      ContingencyIterator iter(p_offsets,
+			       1 + size * (range - 1) / p_numRanges,
+			       1 + size * range / p_numRanges);
+      p_body(range, iter);
+    }
+    catch (std::exception &e) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_contingency_error)
+#endif  // _OPENMP
+      error = e.what();
+    }
+  }
+  if (!error.empty()) {
+    throw Exception(error);
+  }
+}
+
 } // end namespace Gambit
 
 #endif // LIBGAMBIT_STRATITR_H
@@ -142,6 +142,27 @@ public:
   StrategySupportProfile Undominated(bool strong, const Array<int> &players) const;
   //@}
 
+  /// @name Identification of strategies dominated by mixed strategies
+  //@{
+  /// Returns true if the strategy is dominated by a mixture of the
+  /// player's other strategies in the support.  This is decided by
+  /// solving a linear program in exact arithmetic.
+  bool IsMixedDominated(const GameStrategy &s, bool p_strict) const;
+
+  /// Returns a copy of the support with the strategies dominated by
+  /// mixed strategies eliminated, for the players listed.  Each
+  /// player's strategies are screened by linear programs solved in
+  /// floating point on p_numThreads threads; strategies the screen
+  /// cannot rule out are then tested exactly as in IsMixedDominated().
+  StrategySupportProfile MixedUndominated(bool p_strict,
+					  const Array<int> &players,
+					  int p_numThreads = 1) const;
+  /// Returns a copy of the support with the strategies dominated by
+  /// mixed strategies eliminated, for all players
+  StrategySupportProfile MixedUndominated(bool p_strict,
+					  int p_numThreads = 1) const;
+  //@}
+
   /// @name Identification of overwhelmed strategies
   //@{
   bool Overwhelms(const GameStrategy &s, const GameStrategy &t, 
@@ -72,6 +72,12 @@ public:
   bool Check(const Vector<T> &v) const;
 };
 
+// Vectors of doubles use the vectorized kernels in kernels.h
+template<> Vector<double>& Vector<double>::operator+=(const Vector<double>& V);
+template<> Vector<double>& Vector<double>::operator-=(const Vector<double>& V);
+template<> double Vector<double>::operator*(const Vector<double>& V) const;
+template<> double Vector<double>::NormSquared() const;
+
 } // end namespace Gambit
 
 #endif // LIBGAMBIT_VECTOR_H
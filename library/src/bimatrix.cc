@@ -0,0 +1,334 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/bimatrix.cc
+// Dense representation of two-player strategic games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <algorithm>
+
+#include "gambit/gambit.h"
+#include "gambit/gametable.h"
+#include "gambit/bimatrix.h"
+
+namespace Gambit {
+
+namespace {
+
+/// Returns whether x is small in the sense of Integer::is_small()
+inline bool IsSmall(int64_t x)
+{
+  return x > -(int64_t(1) << 31) && x < (int64_t(1) << 31);
+}
+
+inline int64_t Abs(int64_t x) { return (x < 0) ? -x : x; }
+
+//
+// Entries num/den, for Integers and for small numbers.  For small
+// numbers, the quotient in floating point is correctly rounded, and is
+// the same as converting the Rational.
+//
+inline void SetEntry(Rational &p_entry, const Integer &p_num,
+		     const Integer &p_den)
+{ p_entry = Rational(p_num, p_den); }
+
+inline void SetEntry(double &p_entry, const Integer &p_num,
+		     const Integer &p_den)
+{ p_entry = (double) Rational(p_num, p_den); }
+
+inline void SetEntry(Rational &p_entry, int64_t p_num, int64_t p_den)
+{ p_entry = Rational((long) p_num, (long) p_den); }
+
+inline void SetEntry(double &p_entry, int64_t p_num, int64_t p_den)
+{ p_entry = (double) p_num / (double) p_den; }
+
+//
+// Payoffs of a player, as read by BimatrixGame::SetPayoffs()
+//
+class TablePayoffs {
+public:
+  TablePayoffs(const Array<GameOutcomeRep *> &p_results, int p_player)
+    : m_results(p_results), m_player(p_player), m_zero(0) { }
+
+  /// The payoff at index (i, j), counting from zero
+  const Rational &operator()(int i, int j, int p_rows) const
+  {
+    GameOutcomeRep *outcome = m_results[1 + i + j * p_rows];
+    return (outcome) ? outcome->GetPayoff<Rational>(m_player) : m_zero;
+  }
+
+private:
+  const Array<GameOutcomeRep *> &m_results;
+  int m_player;
+  Rational m_zero;
+};
+
+class ArrayPayoffs {
+public:
+  ArrayPayoffs(const Array<Rational> &p_payoffs, bool p_byRows, int p_cols)
+    : m_payoffs(p_payoffs), m_byRows(p_byRows), m_cols(p_cols) { }
+
+  const Rational &operator()(int i, int j, int p_rows) const
+  { return m_payoffs[1 + ((m_byRows) ? i * m_cols + j : i + j * p_rows)]; }
+
+private:
+  const Array<Rational> &m_payoffs;
+  bool m_byRows;
+  int m_cols;
+};
+
+}  // end anonymous namespace
+
+//========================================================================
+//                           class BimatrixGame
+//========================================================================
+
+//------------------------------------------------------------------------
+//                        BimatrixGame: Lifecycle
+//------------------------------------------------------------------------
+
+BimatrixGame::BimatrixGame(const Game &p_game)
+  : m_rows(0), m_cols(0),
+    m_minPayoff(p_game->GetMinPayoff()), m_maxPayoff(p_game->GetMaxPayoff())
+{
+  if (p_game->NumPlayers() != 2) {
+    throw UndefinedException("Method only valid for two-player games.");
+  }
+  m_rows = p_game->GetPlayer(1)->NumStrategies();
+  m_cols = p_game->GetPlayer(2)->NumStrategies();
+
+  const GameTableRep *table =
+    dynamic_cast<const GameTableRep *>(static_cast<GameRep *>(p_game));
+  if (table) {
+    for (int pl = 1; pl <= 2; pl++) {
+      SetPayoffs(pl, TablePayoffs(table->m_results, pl));
+    }
+    return;
+  }
+
+  // The strategic form of a tree has no table, but profiles are visited
+  // in the same order as its contingencies
+  Array<Rational> payoffs1(m_rows * m_cols), payoffs2(m_rows * m_cols);
+  int index = 1;
+  for (StrategyProfileIterator iter(p_game); !iter.AtEnd();
+       iter++, index++) {
+    payoffs1[index] = (*iter)->GetPayoff(1);
+    payoffs2[index] = (*iter)->GetPayoff(2);
+  }
+  SetPayoffs(1, ArrayPayoffs(payoffs1, false, m_cols));
+  SetPayoffs(2, ArrayPayoffs(payoffs2, false, m_cols));
+}
+
+BimatrixGame::BimatrixGame(int p_rows, int p_cols,
+			   const Array<Rational> &p_payoffs1,
+			   const Array<Rational> &p_payoffs2)
+  : m_rows(p_rows), m_cols(p_cols)
+{
+  if (p_rows < 1 || p_cols < 1 ||
+      p_payoffs1.Length() != p_rows * p_cols ||
+      p_payoffs2.Length() != p_rows * p_cols) {
+    throw DimensionException();
+  }
+  m_minPayoff = m_maxPayoff = p_payoffs1[1];
+  for (int index = 1; index <= p_payoffs1.Length(); index++) {
+    for (int pl = 1; pl <= 2; pl++) {
+      const Rational &x = (pl == 1) ? p_payoffs1[index] : p_payoffs2[index];
+      if (x < m_minPayoff)  m_minPayoff = x;
+      if (x > m_maxPayoff)  m_maxPayoff = x;
+    }
+  }
+  SetPayoffs(1, ArrayPayoffs(p_payoffs1, true, p_cols));
+  SetPayoffs(2, ArrayPayoffs(p_payoffs2, true, p_cols));
+}
+
+template <class P>
+void BimatrixGame::SetPayoffs(int pl, const P &p_payoffs)
+{
+  Integer &denom = m_denominators[pl-1];
+  denom = 1;
+  for (int j = 0; j < m_cols; j++) {
+    for (int i = 0; i < m_rows; i++) {
+      const Integer &den = p_payoffs(i, j, m_rows).denominator();
+      if (den != Integer(1)) {
+	denom = lcm(denom, den);
+      }
+    }
+  }
+
+  bool &isSmall = m_isSmall[pl-1];
+  isSmall = denom.is_small();
+  std::vector<int64_t> &smallNumerators = m_smallNumerators[pl-1];
+  if (isSmall) {
+    smallNumerators.resize(m_rows * m_cols);
+    int64_t d = denom.as_int64();
+    for (int j = 0; isSmall && j < m_cols; j++) {
+      for (int i = 0; i < m_rows; i++) {
+	const Rational &x = p_payoffs(i, j, m_rows);
+	if (!x.numerator().is_small()) {
+	  isSmall = false;
+	  break;
+	}
+	int64_t n = x.numerator().as_int64() * (d / x.denominator().as_int64());
+	if (!IsSmall(n)) {
+	  isSmall = false;
+	  break;
+	}
+	smallNumerators[i + j * m_rows] = n;
+      }
+    }
+  }
+  if (isSmall)  return;
+
+  smallNumerators.clear();
+  std::vector<Integer> &numerators = m_numerators[pl-1];
+  numerators.resize(m_rows * m_cols);
+  for (int j = 0; j < m_cols; j++) {
+    for (int i = 0; i < m_rows; i++) {
+      const Rational &x = p_payoffs(i, j, m_rows);
+      numerators[i + j * m_rows] =
+	x.numerator() * (denom / x.denominator());
+    }
+  }
+}
+
+//------------------------------------------------------------------------
+//                        BimatrixGame: Data access
+//------------------------------------------------------------------------
+
+Rational BimatrixGame::GetPayoff(int pl, int i, int j) const
+{
+  int index = (i - 1) + (j - 1) * m_rows;
+  if (m_isSmall[pl-1]) {
+    return Rational(Integer((long) m_smallNumerators[pl-1][index]),
+		    m_denominators[pl-1]);
+  }
+  return Rational(m_numerators[pl-1][index], m_denominators[pl-1]);
+}
+
+//
+// With payoffs N / L, shift sn / sd and factor fn / fd, the transformed
+// payoff is (N * sd - L * sn) * fn / (L * sd * fd); only the numerator
+// depends on the entry.  When all of these numerators, and the
+// denominator, are small, they are computed on machine words.
+//
+template <class T>
+bool BimatrixGame::GetSmallScaledPayoffs(int pl, const Rational &p_shift,
+					 const Rational &p_factor,
+					 Matrix<T> &p_matrix,
+					 int p_row, int p_col,
+					 bool p_transpose) const
+{
+  if (!m_isSmall[pl-1] ||
+      !p_shift.numerator().is_small() || !p_shift.denominator().is_small() ||
+      !p_factor.numerator().is_small() || !p_factor.denominator().is_small()) {
+    return false;
+  }
+  const std::vector<int64_t> &numerators = m_smallNumerators[pl-1];
+  int64_t L = m_denominators[pl-1].as_int64();
+  int64_t sn = p_shift.numerator().as_int64();
+  int64_t sd = p_shift.denominator().as_int64();
+  int64_t fn = p_factor.numerator().as_int64();
+  int64_t fd = p_factor.denominator().as_int64();
+
+  // All the factors are below 2^31, so each product of two is exact
+  int64_t den = L * sd;
+  if (!IsSmall(den) || !IsSmall(den * fd))  return false;
+  den *= fd;
+  int64_t maxNum = 0;
+  for (size_t k = 0; k < numerators.size(); k++) {
+    maxNum = std::max(maxNum, Abs(numerators[k]));
+  }
+  int64_t offset = L * sn;
+  int64_t bound = maxNum * Abs(sd) + Abs(offset);
+  if (bound >= (int64_t(1) << 62) / (Abs(fn) + 1) ||
+      !IsSmall(bound * Abs(fn))) {
+    return false;
+  }
+
+  for (int j = 0; j < m_cols; j++) {
+    for (int i = 0; i < m_rows; i++) {
+      int64_t num = (numerators[i + j * m_rows] * sd - offset) * fn;
+      if (p_transpose) {
+	SetEntry(p_matrix(p_row + j + 1, p_col + i + 1), num, den);
+      }
+      else {
+	SetEntry(p_matrix(p_row + i + 1, p_col + j + 1), num, den);
+      }
+    }
+  }
+  return true;
+}
+
+template <class T>
+void BimatrixGame::GetScaledPayoffs(int pl, const Rational &p_shift,
+				    const Rational &p_factor,
+				    Matrix<T> &p_matrix,
+				    int p_row, int p_col,
+				    bool p_transpose) const
+{
+  if (GetSmallScaledPayoffs(pl, p_shift, p_factor, p_matrix,
+			    p_row, p_col, p_transpose)) {
+    return;
+  }
+
+  Integer denom = m_denominators[pl-1];
+  Integer offset = denom * p_shift.numerator();
+  Integer den = denom * p_shift.denominator() * p_factor.denominator();
+  for (int j = 0; j < m_cols; j++) {
+    for (int i = 0; i < m_rows; i++) {
+      int index = i + j * m_rows;
+      Integer n = (m_isSmall[pl-1]) ?
+	Integer((long) m_smallNumerators[pl-1][index]) :
+	m_numerators[pl-1][index];
+      Integer num = (n * p_shift.denominator() - offset) * p_factor.numerator();
+      if (p_transpose) {
+	SetEntry(p_matrix(p_row + j + 1, p_col + i + 1), num, den);
+      }
+      else {
+	SetEntry(p_matrix(p_row + i + 1, p_col + j + 1), num, den);
+      }
+    }
+  }
+}
+
+template void
+BimatrixGame::GetScaledPayoffs(int, const Rational &, const Rational &,
+			       Matrix<double> &, int, int, bool) const;
+template void
+BimatrixGame::GetScaledPayoffs(int, const Rational &, const Rational &,
+			       Matrix<Rational> &, int, int, bool) const;
+
+Game BimatrixGame::NewTable(void) const
+{
+  Array<int> dim(2);
+  dim[1] = m_rows;
+  dim[2] = m_cols;
+  Game game = Gambit::NewTable(dim);
+  // Outcomes of a new table are numbered in the order of its contingencies
+  for (int j = 1; j <= m_cols; j++) {
+    for (int i = 1; i <= m_rows; i++) {
+      GameOutcome outcome = game->GetOutcome(i + (j - 1) * m_rows);
+      for (int pl = 1; pl <= 2; pl++) {
+	outcome->SetPayoff(pl, lexical_cast<std::string>(GetPayoff(pl, i, j)));
+      }
+    }
+  }
+  return game;
+}
+
+} // end namespace Gambit
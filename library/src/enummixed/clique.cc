@@ -2,7 +2,7 @@
 // This file is part of Gambit
 // Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
 //
-// FILE: src/tools/enummixed/clique.cc
+// FILE: library/src/enummixed/clique.cc
 // Maximal cliques and solution components via von Stengel's algorithm
 //
 // This program is free software; you can redistribute it and/or modify
@@ -20,31 +20,122 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <vector>
+#include <algorithm>
+
 #include "clique.h"
 #include "gambit/gambit.h"
 
 namespace Gambit {
 namespace Nash {
 
-CliqueEnumerator::CliqueEnumerator(Array<Edge> &edgelist, int maxinp1, int maxinp2) 
-  : firstedge(std::min(maxinp1,maxinp2)+1), maxinp1(maxinp1), maxinp2(maxinp2)
+namespace {
+
+const int c_wordBits = 8 * sizeof(unsigned long);
+
+//
+// A connected component: its edges in the order of its edge list, and
+// the original numbers of its nodes in order of first appearance there.
+//
+struct Component {
+  std::vector<int> edges, orignode1, orignode2;
+};
+
+//
+// The search for the maximal cliques of one connected component at a
+// time.  Nodes are renumbered  0..m-1  and  0..n-1  as in  Component,
+// and the incidence matrix is stored as  m  rows of bits.
+//
+class CliqueSearch {
+public:
+  CliqueSearch(void) : m_words(0) { }
+
+  void Run(const Component &p_component, const Array<CliqueEnumerator::Edge> &,
+	   const std::vector<int> &p_newnode1, 
+	   const std::vector<int> &p_newnode2,
+	   std::vector<Array<int> > &p_cliques1,
+	   std::vector<Array<int> > &p_cliques2);
+
+private:
+  int m_words;
+  std::vector<unsigned long> m_connected;
+  std::vector<int> m_stk, m_clique1, m_clique2;
+  const std::vector<int> *m_orignode1, *m_orignode2;
+  std::vector<Array<int> > *m_cliques1, *m_cliques2;
+
+  bool connected(int i, int j) const
+  { return (m_connected[i * m_words + j / c_wordBits] >> (j % c_wordBits)) & 1ul; }
+  /// Makes sure stk[0..size) can be used
+  void reserve(int size)
+  { if ((int) m_stk.size() < size)  m_stk.resize(std::max(size, 2 * (int) m_stk.size())); }
+
+  void candtry1(int cand,  // the candidate from NODES1  to be added to CLIQUE 
+		int cliqsize1,  // CLIQUE so far in NODES1 
+		int cliqsize2,  // CLIQUE so far in NODES2 
+		int sn1, int *sc1, int ec1,   // start NOT1, start CAND1, end CAND1 
+		int sn2, int sc2, int ec2,   // start NOT2, start CAND2, end CAND2 
+		int tos);  // top of stack 
+  void candtry2(int cand,  // the candidate from NODES2  to be added to CLIQUE 
+		int cliqsize1,  // CLIQUE so far in NODES1 
+		int cliqsize2,  // CLIQUE so far in NODES2 
+		int sn1, int sc1, int ec1,   // start NOT1, start CAND1, end CAND1 
+		int sn2, int *sc2, int ec2,   // start NOT2, start CAND2, end CAND2 
+		int tos);  // top of stack 
+  void extend(int cliqsize1,  // CLIQUE so far in NODES1 
+	      int cliqsize2,  // CLIQUE so far in NODES2 
+	      int sn1, int sc1, int ec1,   // start NOT1, start CAND1, end CAND1 
+	      int sn2, int sc2, int ec2,   // start NOT2, start CAND2, end CAND2 
+	      int tos);   // top of stack,   tos >= ec1, ec2  
+  void findfixpoint(int *savelist,      // position of savelist on the stack 
+		    int *tmplist,       // position of tmplist on the stack 
+		    int *minnod,        // currently lowest no. of disconnections 
+		    int sninspect, int ecinspect,
+		    int scother, int ecother,
+		    bool binspect1,  // inspected nodes are in class1, o/w class2 
+		    bool *bfound,  // a new lower no. of disconnections was found 
+		    int *fixp,     // the new fixpoint, if *bfound = true  
+		    int *posfix);    // position of fixpoint on the stack, if *bfound 
+  void outCLIQUE(int cliqsize1, int cliqsize2);
+};
+
+void CliqueSearch::Run(const Component &p_component,
+		       const Array<CliqueEnumerator::Edge> &p_edgelist,
+		       const std::vector<int> &p_newnode1, 
+		       const std::vector<int> &p_newnode2,
+		       std::vector<Array<int> > &p_cliques1,
+		       std::vector<Array<int> > &p_cliques2)
+  /* generates the incidence matrix of the component and computes
+     its cliques via  extend,  appending them to  p_cliques1,2
+  */
 {
-  int numco = getconnco(firstedge, edgelist);
-  workonco(numco, firstedge, edgelist);
+  int m = p_component.orignode1.size(), n = p_component.orignode2.size();
+  m_orignode1 = &p_component.orignode1;
+  m_orignode2 = &p_component.orignode2;
+  m_cliques1 = &p_cliques1;
+  m_cliques2 = &p_cliques2;
+
+  m_words = (n + c_wordBits - 1) / c_wordBits;
+  m_connected.assign(m * m_words, 0ul);
+  for (size_t k = 0; k < p_component.edges.size(); k++) {
+    const CliqueEnumerator::Edge &edge = p_edgelist[p_component.edges[k]];
+    int newi = p_newnode1[edge.node1], newj = p_newnode2[edge.node2];
+    m_connected[newi * m_words + newj / c_wordBits] |= 1ul << (newj % c_wordBits);
+  }
+  m_clique1.resize(m);
+  m_clique2.resize(n);
+
+  /* initialize stack with the full sets of nodes
+     and empty sets CAND and NOT  */
+  reserve(m + n);
+  int tos = 0;
+  for (int i=0; i<m; i++)  m_stk[tos++] = i;   // CAND1 = NODES1 
+  for (int i=0; i<n; i++)  m_stk[tos++] = i;   // CAND2 = NODES2 
+  extend(0, 0, 0, 0, m, m, m, m+n, tos);
 }
 
-void CliqueEnumerator::
-candtry1 (int stk[], // stack 
-	  bool connected[MAXM][MAXN],
-	  int cand,  // the candidate from NODES1  to be added to CLIQUE 
-	  int clique1[], int cliqsize1,  // CLIQUE so far in NODES1 
-	  int clique2[], int cliqsize2,  // CLIQUE so far in NODES2 
-	  int sn1, int *sc1, int ec1,   // start NOT1, start CAND1, end CAND1 
-	  int sn2, int sc2, int ec2,   // start NOT2, start CAND2, end CAND2 
-	  int tos,  // top of stack 
-	  int orignode1[MAXM],
-	  int orignode2[MAXN]
-	  )
+void CliqueSearch::candtry1(int cand, int cliqsize1, int cliqsize2,
+			    int sn1, int *sc1, int ec1,
+			    int sn2, int sc2, int ec2, int tos)
   /* recurses down by moving  cand  from  CAND1  to  clique1  and
      then to NOT1  after extension.
      clique1  is extended by  cand  where all points in  NOT2 and CAND2 
@@ -56,53 +147,40 @@ candtry1 (int stk[], // stack
 {
   int i, j, snnew, scnew, ecnew;
   
-  clique1[cliqsize1++] = cand ;
+  m_clique1[cliqsize1++] = cand ;
   // remove  cand  from CAND1 by replacing it with the last element of CAND1 
   for (i=*sc1; i<ec1; i++)
-      if (cand == stk[i]) {
-         stk[i] = stk[--ec1] ;
+      if (cand == m_stk[i]) {
+         m_stk[i] = m_stk[--ec1] ;
          break ;
          }
   // stk[ec1] is free now but will after extension be needed again 
   // fill new sets NOT2, CAND2 
+  reserve(tos + ec2 - sn2);
   snnew = tos ;
   for (j=sn2; j<sc2; j++) 
-    if (connected[cand][stk[j]])
-      stk[tos++] = stk[j] ;
+    if (connected(cand, m_stk[j]))
+      m_stk[tos++] = m_stk[j] ;
   scnew = tos ;
   for (j=sc2; j<ec2; j++) 
-    if (connected[cand][stk[j]])
-      stk[tos++] = stk[j] ;
+    if (connected(cand, m_stk[j]))
+      m_stk[tos++] = m_stk[j] ;
   ecnew = tos ;
   
-  extend(stk, connected, clique1, cliqsize1, clique2, cliqsize2,
-	 sn1, *sc1, ec1, snnew, scnew, ecnew, tos, orignode1, orignode2);
+  extend(cliqsize1, cliqsize2, sn1, *sc1, ec1, snnew, scnew, ecnew, tos);
   
   /* remove  cand  from  clique1,
      put  cand  into  NOT1  by increasing  *sc1  and moving
      the node at position  *sc1  to the end of CAND1 */
-  // The following lines modified since ec1 and cliqsize1 are
-  // never used after the increments
-  //cliqsize1-- ;
-  //stk[ec1++] = stk[*sc1] ;
-  stk[ec1] = stk[*sc1];
-  stk[*sc1] = cand ;
+  m_stk[ec1] = m_stk[*sc1];
+  m_stk[*sc1] = cand ;
   (*sc1)++ ;
 }
 
 // -------------------------------------------------- 
-void CliqueEnumerator::
-candtry2 (int stk[], // stack 
-	  bool connected[MAXM][MAXN],
-	  int cand,  // the candidate from NODES2  to be added to CLIQUE 
-	  int clique1[], int cliqsize1,  // CLIQUE so far in NODES1 
-	  int clique2[], int cliqsize2,  // CLIQUE so far in NODES2 
-	  int sn1, int sc1, int ec1,   // start NOT1, start CAND1, end CAND1 
-	  int sn2, int *sc2, int ec2,   // start NOT2, start CAND2, end CAND2 
-	  int tos,  // top of stack 
-	  int orignode1[MAXM],
-	  int orignode2[MAXN]
-	  )
+void CliqueSearch::candtry2(int cand, int cliqsize1, int cliqsize2,
+			    int sn1, int sc1, int ec1,
+			    int sn2, int *sc2, int ec2, int tos)
   // recurses down by moving  cand  from  CAND2  to  clique2  and
   // then to NOT2  after extension;
   // clique2  is extended by  cand  where all points in  NOT1 and CAND1 
@@ -110,57 +188,43 @@ candtry2 (int stk[], // stack
   // pre:  cand  is in CAND2
   // post: cand  is moved from  CAND2  to  NOT2
   // CAND2 may be shuffled,  o/w stack unchanged
-  
 {
   int i, j,  snnew, scnew, ecnew;
   
-  clique2[cliqsize2++] = cand ;
+  m_clique2[cliqsize2++] = cand ;
   // remove  cand  from CAND2 by replacing it with the last element of CAND2 
   for (j=*sc2; j<ec2; j++)
-      if (cand == stk[j]) {
-	 stk[j] = stk[--ec2] ;
+      if (cand == m_stk[j]) {
+	 m_stk[j] = m_stk[--ec2] ;
 	 break ;
 	 }
   // stk[ec2] is free now but will after extension be needed again 
   // fill new sets NOT1, CAND1 
+  reserve(tos + ec1 - sn1);
   snnew = tos ;
   for (i=sn1; i<sc1; i++) 
-    if (connected[stk[i]][cand])
-      stk[tos++] = stk[i] ;
+    if (connected(m_stk[i], cand))
+      m_stk[tos++] = m_stk[i] ;
   scnew = tos ;
   for (i=sc1; i<ec1; i++) 
-    if (connected[stk[i]][cand])
-      stk[tos++] = stk[i] ;
+    if (connected(m_stk[i], cand))
+      m_stk[tos++] = m_stk[i] ;
   ecnew = tos ;
   
-  extend(stk, connected, clique1, cliqsize1, clique2, cliqsize2,
-	 snnew, scnew, ecnew, sn2, *sc2, ec2, tos, orignode1, orignode2);
+  extend(cliqsize1, cliqsize2, snnew, scnew, ecnew, sn2, *sc2, ec2, tos);
   
   // remove  cand  from  clique2,
   // put  cand  into  NOT2  by increasing  *sc2  and moving
-  // the node at position  sc2  to the end of CAND1 
-
-  // The following lines modified since ec2 and cliqsize2 are not used
-  // after the increments
-  // cliqsize2-- ;
-  // stk[ec2++] = stk[*sc2] ;
-  stk[ec2] = stk[*sc2];
-  stk[*sc2] = cand ;
+  // the node at position  sc2  to the end of CAND2 
+  m_stk[ec2] = m_stk[*sc2];
+  m_stk[*sc2] = cand ;
   (*sc2)++ ;
 }
 
 // -------------------------------------------------- 
-void CliqueEnumerator::
-extend (int stk[], // stack 
-	bool connected[MAXM][MAXN],
-	int clique1[], int cliqsize1,  // CLIQUE so far in NODES1 
-	int clique2[], int cliqsize2,  // CLIQUE so far in NODES2 
-	int sn1, int sc1, int ec1,   // start NOT1, start CAND1, end CAND1 
-	int sn2, int sc2, int ec2,   // start NOT2, start CAND2, end CAND2 
-	int tos,   // top of stack,   tos >= ec1, ec2  
-	int orignode1[MAXM],   // original node numbers as input 
-	int orignode2[MAXN]
-	)
+void CliqueSearch::extend(int cliqsize1, int cliqsize2,
+			  int sn1, int sc1, int ec1,
+			  int sn2, int sc2, int ec2, int tos)
   /* extends the current set CLIQUE or outputs it if
      NOT and CAND are empty.
      
@@ -181,8 +245,7 @@ extend (int stk[], // stack
     //  CAND is empty  
     if (sn1 == sc1 && sn2 == sc2)
       //  NOT is empty, otherwise do nothing  
-      outCLIQUE(clique1, cliqsize1, clique2, cliqsize2,
-                orignode1, orignode2) ;
+      outCLIQUE(cliqsize1, cliqsize2) ;
   }
   
   else {  //  CAND not empty 
@@ -195,11 +258,9 @@ extend (int stk[], // stack
     cmax = std::max(ec1-sc1, ec2-sc2);  // the larger of |CAND1|, |CAND2|  
     
     // reserve two arrays of size cmax on the stack 
+    reserve(tos + 2 * cmax);
     firstlist = tmplist = tos;  tos += cmax;
     savelist = tos;  
-
-    // tos is not used again.. 
-    // tos += cmax;
     
     /* find fixpoint  fixp (a node of the graph) in  NOT  or  CAND
        which has the smallest possible number of disconnections  minnod 
@@ -207,12 +268,12 @@ extend (int stk[], // stack
     minnod = cmax + 1 ;
     
     // look for  fixp  in NODES1  
-    findfixpoint(stk, connected, &savelist, &tmplist, &minnod,
+    findfixpoint(&savelist, &tmplist, &minnod,
 		 sn1, ec1, sc2, ec2, 1, &bfixin1, &fixp, &posfix) ;
     bcandfix = (posfix >= sc1);
     
     // look for  fixp  in nodes2  
-    findfixpoint(stk, connected, &savelist, &tmplist, &minnod,
+    findfixpoint(&savelist, &tmplist, &minnod,
 		 sn2, ec2, sc1, ec1, 0, &bfound, &fixp, &posfix) ;
     
     if (bfound) {
@@ -233,54 +294,38 @@ extend (int stk[], // stack
     */
     if (savelist != firstlist) {int i;
     for (i=0; i < minnod; i++) 
-      stk[firstlist + i] = stk[savelist + i];
+      m_stk[firstlist + i] = m_stk[savelist + i];
     savelist = firstlist ;
     }
     tos = savelist + minnod;
     
     if (bfixin1) {int j;  // fixpoint in NODES1  
     if (bcandfix)      // fixpoint is a candidate 
-      candtry1(stk, connected, fixp, 
-	       clique1, cliqsize1, clique2, cliqsize2,
-	       sn1, &sc1, ec1, sn2, sc2, ec2, tos, orignode1, orignode2);
+      candtry1(fixp, cliqsize1, cliqsize2,
+	       sn1, &sc1, ec1, sn2, sc2, ec2, tos);
     // fixpoint is now in NOT1, try all the nodes disconnected to it 
     for (j=0; j<minnod;  j++) 
-      candtry2(stk, connected, stk[savelist+j],
-	       clique1, cliqsize1, clique2, cliqsize2,
-	       sn1, sc1, ec1, sn2, &sc2, ec2, tos, orignode1, orignode2);
+      candtry2(m_stk[savelist+j], cliqsize1, cliqsize2,
+	       sn1, sc1, ec1, sn2, &sc2, ec2, tos);
     }
     else {int j;          // fixpoint in NODES2  
     if (bcandfix)      // fixpoint is a candidate 
-      candtry2(stk, connected, fixp,
-	       clique1, cliqsize1, clique2, cliqsize2,
-	       sn1, sc1, ec1, sn2, &sc2, ec2, tos, orignode1, orignode2);
+      candtry2(fixp, cliqsize1, cliqsize2,
+	       sn1, sc1, ec1, sn2, &sc2, ec2, tos);
     // fixpoint is now in NOT2, try all the nodes disconnected to it 
     for (j=0; j<minnod;  j++) 
-      candtry1(stk, connected, stk[savelist+j],
-	       clique1, cliqsize1, clique2, cliqsize2,
-	       sn1, &sc1, ec1, sn2, sc2, ec2, tos, orignode1, orignode2);
+      candtry1(m_stk[savelist+j], cliqsize1, cliqsize2,
+	       sn1, &sc1, ec1, sn2, sc2, ec2, tos);
     }
   }  // end candidates not empty 
 } 
 
 // -------------------------------------------------- 
-void CliqueEnumerator::
-findfixpoint(int stk[], // stack 
-	     bool connected[MAXM][MAXN],
-	     int *savelist,      // position of savelist on the stack 
-	     int *tmplist,       // position of tmplist on the stack 
-	     // might be swapped afterwards 
-	     int *minnod,        // currently lowest no. of disconnections 
-	     int sninspect, int ecinspect, /* range of stack positions
-					      containing the nodes inspected 
-					      as possible fixpoints */
-	     int scother, int ecother,
-	     // range of corresponding candidates on the other side  
-	     bool binspect1,  // inspected nodes are in class1, o/w class2 
-	     bool *bfound,  // a new lower no. of disconnections was found 
-	     int *fixp,     // the new fixpoint, if *bfound = true  
-	     int *posfix    // position of fixpoint on the stack, if *bfound 
-	     )
+void CliqueSearch::findfixpoint(int *savelist, int *tmplist, int *minnod,
+				int sninspect, int ecinspect,
+				int scother, int ecother,
+				bool binspect1, bool *bfound,
+				int *fixp, int *posfix)
   /* pre:  enough space on stack for the two lists  savelist,  tmplist
      post: *minnod contains the new minimum no. of disconnections
      stk[*savelist, +*minnod] contains the candidates disconnected to
@@ -293,15 +338,15 @@ findfixpoint(int stk[], // stack
   *bfound = false ;
   
   for (i=sninspect; i<ecinspect; i++) {
-    p = stk[i] ;
+    p = m_stk[i] ;
     count = 0;
     /* count number of disconnections to  p,  
        building up stk[tmplist+count] containing the
        disconnected points */
     for (j=scother; (j<ecother) && (count < *minnod); j++) {
-      int k = stk[j] ;
-      if (!( binspect1 ? connected[p][k] : connected[k][p] )) {
-         stk[(*tmplist) + count] = k ;
+      int k = m_stk[j] ;
+      if (!( binspect1 ? connected(p, k) : connected(k, p) )) {
+         m_stk[(*tmplist) + count] = k ;
          count ++ ;
       }
     }  // end loop j, comparing to other side 
@@ -320,267 +365,185 @@ findfixpoint(int stk[], // stack
 }
 
 // -------------------------------------------------- 
-void CliqueEnumerator::genincidence(
-			       int e,
-			       Array<Edge> &edgelist,
-			       int orignode1[MAXM],
-			       int orignode2[MAXN],
-			       bool connected[MAXM][MAXN],
-			       int *m,
-			       int *n
-			       )
-  /* generates the incidence matrix  connected from the edgelist
-     starting with edgelist[e]
-     pre:  all nodes in edgelist < maxinp1,2
-     post: orignode1[0..*m) contains the original node1 numbers
-     orignode2[0..*n) contains the original node2 numbers
-     connected[][] == true if edge, o/w false
-     *m == number of rows 
-     *n == number of columns
-     */
+void CliqueSearch::outCLIQUE(int cliqsize1, int cliqsize2)
+  // outputs  CLIQUE  using the original node numbers in  orignode
 {
-  Array<int> newnode1(0,maxinp1-1) ;
-  Array<int> newnode2(0,maxinp2-1) ;
-  int i,j, newi, newj ;
-  
-  // init newnode 
-  for (i=0; i<maxinp1; i++)  newnode1[i] = -1;
-  for (j=0; j<maxinp2; j++)  newnode2[j] = -1;
-  
-  /* init connected for test ; note different dimension 
-     for (i=0; i<MAXM; i++)
-     for (j=0; j<MAXN; j++)  connected[i][j] = 2;    
-  */
-  
-  *m = *n = 0;
-  
-  while (e) { // process the edge list with edge index e 
-    i= edgelist[e].node1;
-    j= edgelist[e].node2;
-    newi = newnode1[i] ;
-    newj = newnode2[j] ;
-    if (newi == -1) {
-      if (*m >= MAXM) { // out of bounds for connected, reject 
-	printf("Left bound %d for incidence matrix ", MAXM ) ;
-	printf("reached, edge (%d, %d) rejected\n", i, j);
-	goto KEEPGOING ;
-      }
-      else {
-	int k;
-	newi = (*m) ++ ;
-	// init connected on the fly 
-	for (k=0; k<MAXN; k++)  connected[newi][k] = false;
-	newnode1[i] = newi ;
-	orignode1[newi] = i ;
-      }
+  if (cliqsize1>0 && cliqsize2>0) {
+    Array<int> cliq1(cliqsize1), cliq2(cliqsize2);
+    for (int i=0; i<cliqsize1; i++) {
+      cliq1[i+1] = (*m_orignode1)[m_clique1[i]];
     }
-    if (newj == -1) {
-      if (*n >= MAXN) { // out of bounds for connected, reject 
-	printf("Right bound %d for incidence matrix ", MAXN ) ;
-	printf("reached, edge (%d, %d) rejected\n", i, j);
-	goto KEEPGOING ;
-      }
-      else {
-	newj = (*n) ++ ;
-	newnode2[j] = newj ;
-	orignode2[newj] = j ;
-      }
+    for (int i=0; i<cliqsize2; i++) {
+      cliq2[i+1] = (*m_orignode2)[m_clique2[i]];
     }
-    connected[newi][newj] = true ;
-    
-  KEEPGOING:
-    e = edgelist[e].nextedge ;
+    m_cliques1->push_back(cliq1);
+    m_cliques2->push_back(cliq2);
   }
 }
 
 // -------------------------------------------------- 
-int CliqueEnumerator::getconnco(Array<int> &firstedge,
-			   Array<Edge> &edgelist
-			   )
-  
-  /* reads edges of bipartite graph from input, puts them in disjoint
-     lists of edges representing its connected components 
-     pre:  nodes are nonzero integers < maxinp1,2
-     other edges are rejected, and so are edges starting
-     from the MAXEDGEth edge on and larger, each with a warning msg.
-     post: return value == numco  (largest index of a connected component)
-     where  numco < MAXCO,  and for   1 <= co <= numco:
-     edgelist[co].firstedge == 0    if  co  is not a component
-     == edgeindex  e  otherwise where  e > 0  and
-     edgelist[e].node1, .node2[e] are endpoints of edge,
-     edgelist[e].nextedge == next edgeindex of component,
-     zero if  e  is index to the last edge
+int find(std::vector<int> &parent, int i)
+  // root of the union-find tree of  i,  halving the path on the way
+{
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+// -------------------------------------------------- 
+void getconnco(const Array<CliqueEnumerator::Edge> &edgelist,
+	       std::vector<Component> &components,
+	       std::vector<int> &newnode1,
+	       std::vector<int> &newnode2)
+  /* puts the edges of the bipartite graph in disjoint lists of
+     edges representing its connected components,  which are
+     returned in the order of their numbers,  and numbers the nodes
+     of each component in order of first appearance in its list
+     pre:  nodes are nonnegative integers
+     post: newnode1,2[i] is the new number of node i,  or -1 if
+     it is not in any edge
   */
 {
-  int numco, newedge ;
-  Array<int> co1(0,maxinp1-1), co2(0,maxinp2-1);   // components of node1,2  
-  int i, j;  // indices to left and right nodes 
-  
-  // initialize  component indices of left and right nodes 
-  for (i=0; i<maxinp1; i++)
-    co1[i] = 0;
-  for (j=0; j<maxinp2; j++)
-    co2[j] = 0;
-  
-  numco = 0;
-  for(newedge = 1;newedge<=edgelist.Length();newedge++) {
-    i = edgelist[newedge].node1;
-    j = edgelist[newedge].node2;
-    
-    if (i < 0 || i>= maxinp1 || j<0 || j>=maxinp2)
-      printf("Edge (%d, %d) not in admitted range (0..%d, 0..%d), rejected\n",
-	     i,j, maxinp1-1, maxinp2-1) ;
-    else { 
-      // add edge (i,j) to current componentlist 
-      int  ico, jco ;  // current components of i,j  
-      ico = co1[i] ;
-      jco = co2[j] ;
+  int maxinp1 = 0, maxinp2 = 0;
+  for (int e = 1; e <= edgelist.Length(); e++) {
+    if (edgelist[e].node1 < 0 || edgelist[e].node2 < 0) {
+      throw IndexException();
+    }
+    maxinp1 = std::max(maxinp1, edgelist[e].node1 + 1);
+    maxinp2 = std::max(maxinp2, edgelist[e].node2 + 1);
+  }
+
+  // Left node i is element i of the union-find forest, right node j
+  // is element  maxinp1 + j;  -1 if the node has not been seen yet.
+  // The component number of a tree is kept at its root.
+  std::vector<int> parent(maxinp1 + maxinp2, -1), co(maxinp1 + maxinp2, 0);
+  // edge lists: first and last edge of each component, next edge
+  std::vector<int> firstedge(edgelist.Length() + 1, 0);
+  std::vector<int> lastedge(edgelist.Length() + 1, 0);
+  std::vector<int> nextedge(edgelist.Length() + 1, 0);
+  int numco = 0;
+
+  for (int newedge = 1; newedge <= edgelist.Length(); newedge++) {
+    int i = edgelist[newedge].node1;
+    int j = maxinp1 + edgelist[newedge].node2;
+    int iroot = (parent[i] >= 0) ? find(parent, i) : -1;
+    int jroot = (parent[j] >= 0) ? find(parent, j) : -1;
+    int ico = (iroot >= 0) ? co[iroot] : 0;
+    int jco = (jroot >= 0) ? co[jroot] : 0;
       
-      if (ico == 0) {
-	//  i  has not yet been in a component before  
-	if (jco == 0) {
-	  //  j  has not yet been in a component before  
-	  //  add a new component  
-	  numco ++;
-	  co1[i] = co2[j] = numco ;
-	  firstedge[numco] = newedge ;
-	  edgelist[newedge].nextedge  = 0;
-	}
-	else { /* j  is already in a component: add  i  to j's
-		  component, adding list elements in front */
-	  co1[i] = jco ;
-	  edgelist[newedge].nextedge  = firstedge[jco];
-	  firstedge[jco] = newedge;
-	}
+    if (ico == 0 && jco == 0) {
+      //  add a new component  
+      numco++;
+      parent[i] = parent[j] = i;
+      co[i] = numco;
+      firstedge[numco] = lastedge[numco] = newedge;
+      nextedge[newedge] = 0;
+    }
+    else if (ico == 0 || jco == 0 || ico == jco) {
+      // add the new node, if any, and the current edge in front 
+      // of the list of the existing component
+      int root = (iroot >= 0) ? iroot : jroot;
+      int cur = co[root];
+      if (iroot < 0)  parent[i] = root;
+      if (jroot < 0)  parent[j] = root;
+      nextedge[newedge] = firstedge[cur];
+      firstedge[cur] = newedge;
+    }
+    else { 
+      /*  i  and  j  in different components: prepend the current
+	  edge to the list of the one with the higher number, and
+	  the result to the list of the one with the lower number */
+      int newco, oldco, newroot, oldroot;
+      if (ico < jco) { 
+	newco = ico; oldco = jco; newroot = iroot; oldroot = jroot;
       }
-      else { // i  is already in a component 
-	if (jco == 0) {
-	  //  j  has not yet been in a component before  
-	  //  add  j  to  i's component  
-	  co2[j] = ico ;
-	  edgelist[newedge].nextedge  = firstedge[ico];
-	  firstedge[ico] = newedge;
-	}
-	else { // i  and  j  are already in components  
-	  if (ico == jco) {
-	    // i, j  in same component: just add the current edge 
-	    edgelist[newedge].nextedge  = firstedge[ico];
-	    firstedge[ico] = newedge;
-	  }
-	  else { /*  i  and  j  in different components:  
-		     merge these by traversing the edgelists
-		     and updating components of all incident nodes
-		     (this is wasteful since only nodes need be
-		     updated, not edges)  */
-	    int e, newco, oldco ;
-	    if (ico < jco) { newco = ico; oldco = jco; }
-	    else           { newco = jco; oldco = ico; }
-	    // insert the current edge 
-	    edgelist[newedge].nextedge= firstedge[oldco] ;
-	    e = newedge ; 
-	    while (1) {
-	      co1[edgelist[e].node1] = co2[edgelist[e].node2] = newco ;
-	      if (edgelist[e].nextedge == 0) break;
-	      e = edgelist[e].nextedge;
-	    }
-	    //  e  is now the last edge in the updated list  
-	    edgelist[e].nextedge = firstedge[newco] ;
-	    firstedge[newco] = newedge ;
-	    /* oldco is unused now: reuse it if it was the 
-	       last component, otherwise just leave empty */
-	    if (oldco == numco) numco-- ;
-	    firstedge[oldco] = 0;
-	  }
-	}
+      else { 
+	newco = jco; oldco = ico; newroot = jroot; oldroot = iroot;
       }
+      nextedge[newedge] = firstedge[oldco];
+      nextedge[lastedge[oldco]] = firstedge[newco];
+      firstedge[newco] = newedge;
+      parent[oldroot] = newroot;
+      /* oldco is unused now: reuse it if it was the 
+	 last component, otherwise just leave empty */
+      if (oldco == numco) numco-- ;
+      firstedge[oldco] = 0;
     }
   }  // end scanning input 
-  return numco;
+
+  newnode1.assign(maxinp1, -1);
+  newnode2.assign(maxinp2, -1);
+  for (int c = 1; c <= numco; c++) {
+    if (firstedge[c] == 0)  continue;
+    components.push_back(Component());
+    Component &component = components.back();
+    for (int e = firstedge[c]; e != 0; e = nextedge[e]) {
+      int i = edgelist[e].node1, j = edgelist[e].node2;
+      component.edges.push_back(e);
+      if (newnode1[i] == -1) {
+	newnode1[i] = component.orignode1.size();
+	component.orignode1.push_back(i);
+      }
+      if (newnode2[j] == -1) {
+	newnode2[j] = component.orignode2.size();
+	component.orignode2.push_back(j);
+      }
+    }
+  }
 }
 
+}  // end anonymous namespace
 
-// -------------------------------------------------- 
-void CliqueEnumerator::outCLIQUE(int clique1[], int cliqsize1, 
-			    int clique2[], int cliqsize2,
-			    int orignode1[MAXM],
-			    int orignode2[MAXN]
-			    ) 
-  // outputs  CLIQUE  using the original node numbers in  orignode
-  
+CliqueEnumerator::CliqueEnumerator(const Array<Edge> &p_edgelist,
+				   int p_numThreads)
 {
-  if (cliqsize1>0 && cliqsize2>0) {
-    int i;
-    //printf("{") ;
-    Array<int> cliq1;
-    for (i=0; i<cliqsize1; i++) {
-      cliq1.Append(orignode1[clique1[i]]);
-      //printf("%d", orignode1[clique1[i]]);
-      //if (i<cliqsize1-1) printf(", "); 
-    }
-    m_cliques1.Append(cliq1);
-
-    //printf("}  x  {") ;
-    //  the  "x"  in the output symbolizes the product set 
+  std::vector<Component> components;
+  std::vector<int> newnode1, newnode2;
+  getconnco(p_edgelist, components, newnode1, newnode2);
 
-    Array<int> cliq2;
-    for (i=0; i<cliqsize2; i++) {
-      cliq2.Append(orignode2[clique2[i]]);
-      //printf("%d", orignode2[clique2[i]]);
-      //if (i<cliqsize2-1) printf(", "); 
+  int numco = components.size();
+  std::vector<std::vector<Array<int> > > cliques1(numco), cliques2(numco);
+  std::string error;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(p_numThreads) if (p_numThreads > 1 && numco > 1)
+#endif  // _OPENMP
+  {
+    CliqueSearch search;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif  // _OPENMP
+    for (int co = 0; co < numco; co++) {
+      try {
+	search.Run(components[co], p_edgelist, newnode1, newnode2,
+		   cliques1[co], cliques2[co]);
+      }
+      catch (std::exception &e) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_clique_error)
+#endif  // _OPENMP
+	error = e.what();
+      }
     }
-    m_cliques2.Append(cliq2);
-    //    printf("}\n");
   }
-}
+  if (!error.empty()) {
+    throw Exception(error);
+  }
 
-// -------------------------------------------------- 
-void CliqueEnumerator::workonco(int numco,
-			   Array<int> &firstedge,
-			   Array<Edge> &edgelist
-			   )
-  /* works on the edgelists as generated by  getconnco
-     it processes each component by computing its maximal cliques 
-     pre : firstedge[1..numco], if nonzero, points to a connected component
-     in edgelist
-     post: all components are processed
-  */
-{
-  int orignode1[MAXM];
-  int orignode2[MAXN];
-  bool connected[MAXM][MAXN];
-  int m; int n;   // graph dimensions 
-  
-  int stk[STKSIZE];  // stack 
-  int tos;  // top of stack 
-  int clique1[MAXM], clique2[MAXN];
-  // CLIQUE for first and second node class  
-  
-  int co;
-  int countco = 0;
-  
-  for (co=1; co <= numco; co++) 
-    if (firstedge[co]) {
-      // found a nonzero component list 
-      countco ++ ;
-      //printf("\nConnected component %d:\n", countco) ;
-      
-      genincidence(firstedge[co], edgelist,
-		   orignode1, orignode2, connected, &m, &n);
-      
-      /* compute the cliques of the component via  extend;
-	 initialize stack with the full sets of nodes
-	 and empty sets CAND and NOT  */
-      tos = 0;
-      {
-	int i ;
-	for (i=0; i<m; i++)  stk[tos++] = i;   // CAND1 = NODES1 
-	for (i=0; i<n; i++)  stk[tos++] = i;   // CAND2 = NODES2 
-      }
-      extend(stk, connected, clique1, 0, clique2, 0,
-	     0, 0, m, m, m, m+n, tos, orignode1, orignode2);
+  int numcliques = 0;
+  for (int co = 0; co < numco; co++) {
+    numcliques += cliques1[co].size();
+  }
+  m_cliques1 = Array<Array<int> >(numcliques);
+  m_cliques2 = Array<Array<int> >(numcliques);
+  for (int co = 0, cl = 1; co < numco; co++) {
+    for (size_t k = 0; k < cliques1[co].size(); k++, cl++) {
+      m_cliques1[cl] = cliques1[co][k];
+      m_cliques2[cl] = cliques2[co][k];
     }
+  }
 }
 
 }  // end namespace Gambit::Nash
 }  // end namespace Gambit
-
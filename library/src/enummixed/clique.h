@@ -58,37 +58,27 @@
 //    [BK] C. Bron and J. Kerbosch, Finding all cliques of an undirected
 //         graph, Comm. ACM 16:9 (1973), 575-577.
 //
-//    APPROXIMATE STORAGE REQUIREMENTS:
-//    for integer arrays, 4 bytes per integer, using constants
-//    maxinp1, maxinp2  max. node indices in input
-//    MAXEDGES          max. no. edges in input
-//    MAXM, MAXN        max. dimension of incidence matrix
-//   	              per connected component
-//    2 x MAXM x MAXN  integers for incidence matrix and stack
-//	   [2 MB  if MAXM = MAXN = 700 ]
-//    3 x MAXEDGES  integers for edge list
-//	   [0.6 MB  if  MAXEDGES = 50000 ]
-//    3 x maxinp1  integers for input nodes and list of components
-//	   [60 kB   if  maxinp1 = maxinp2 = 5000 ]
-//    If these constants are exceeded certain edges will be rejected
-//    from the input with an error message.  Program shouldn't crash.
-//    No error value is returned by  main().
+//    STORAGE REQUIREMENTS:
+//    There are no fixed limits on the number of nodes or edges.
+//    The incidence matrix of each connected component is kept as
+//    rows of bits, so a component with  m  left and  n  right nodes
+//    takes  m x n  bits; the stack grows as needed, and needs at most
+//    (m + 1) x (n + 1)  integers for a complete bipartite graph.
 //
 //    DETAILS OF METHODS:
 //
 //    a) Connected components
 //
-//    Designed for minimum storage requirement, running time
-//    possibly quadratic in number of edges.
-//    For each node that is read, a component  co1[i]  resp.  co2[j]
-//    ( i  left node,  j  right node) is kept, initially  0  if node
-//    is not yet input.  (Isolated nodes are treated as absent.)
+//    A component is created for an edge with two new nodes, taking
+//    the next number after the highest one in use.  Each component
+//    keeps a linked list of its edges.
 //    For an edge  (i, j),  i and j  must be put in the same component.
-//    Each component  co  points to the first edge in  edgelist,
-//    where the edges are linked.  Merging two components is done
-//    by traversing the edgelist with the higher number, updating
-//    the component number of the nodes therein, and prepending
-//    it to the list of the other component.
+//    If they are in different components, the one with the higher
+//    number is merged into the one with the lower number: the new
+//    edge is prepended to the edge list of the higher one, and the
+//    result to the list of the lower one.  The component each node
+//    belongs to is found with union-find, so this takes time almost
+//    linear in the number of edges.
 //    Components and edges are numbered starting with 1,  so "no
 //    component" and the end of an edgelist is represented by 0.
 //
@@ -97,10 +87,6 @@
 //    array elements [0..k) i.e. [0..k-1],  if starting with 1
 //    they are [1..k].
 //
-//    A possible improvement is to keep extra lists of the
-//    equivalence classes for the nodes for each component so only
-//    these have to be updated, which makes it faster.  
-//    
 //    b) Clique enumeration
 //
 //    The procedure  extend  recursively extends a current set of pairs
@@ -118,6 +104,11 @@
 //    to the recursive call.  The top of the stack  tos  is passed
 //    as a parameter.
 //
+//    The components are independent of each other, so with several
+//    threads their cliques are found concurrently, each thread
+//    with its own stack and incidence matrix.  The cliques are
+//    reported component by component in the order above.
+//
 //    The extension is done by adding points from a set CAND of 
 //    candidates to CLIQUE.  Throughout, the points in CAND are
 //    connected to all points in  CLIQUE,  which holds at initialization
@@ -178,33 +169,19 @@
 #ifndef GAMBIT_ENUMMIXED_CLIQUE_H
 #define GAMBIT_ENUMMIXED_CLIQUE_H
 
-#include <cstdio>
 #include "gambit/gambit.h"
 
 namespace Gambit {
 namespace Nash {
 
-#define MAXM 700     // max. no of left nodes for incidence matrix 
-#define MAXN MAXM  // max. no of right nodes for incidence matrix 
-
-#define MAXINP1 5000        // max. no of left nodes in input 
-#define MAXINP2 MAXINP1  // max. no of right nodes in input 
-#define MAXEDGES   50000       // max. no of edges in input 
-#define MAXCO  MIN(MAXINP1, MAXINP2) + 1
-  // max. no of connected components;  on the smaller side,
-  // each node could be in different component 
-#define STKSIZE  (MAXM + 1) * (MAXN + 1)  
-  // largest stack usage for full graph 
-
-
 class CliqueEnumerator {
 public:
   class Edge {
   public:
     int node1;
     int node2;
-    int nextedge;
     Edge() { }
+    Edge(int p_node1, int p_node2) : node1(p_node1), node2(p_node2) { }
     ~Edge() { } 
     bool operator==(const Edge &y) const 
     { return (node1 == y.node1 && node2 == y.node2); }
@@ -212,81 +189,21 @@ public:
     { return !(*this == y); }
   };
 
-  CliqueEnumerator(Array<Edge> &, int, int);
+  /// Finds the maximal cliques of the bipartite graph with the given
+  /// edges, whose endpoints must be nonnegative.  The components
+  /// are searched on up to p_numThreads threads.
+  CliqueEnumerator(const Array<Edge> &, int p_numThreads = 1);
   ~CliqueEnumerator() { }
 
-  const List<Array<int> > &GetCliques1(void) const { return m_cliques1; }
-  const List<Array<int> > &GetCliques2(void) const { return m_cliques2; }
+  /// The cliques U x V, as the sets U of left and V of right nodes
+  const Array<Array<int> > &GetCliques1(void) const { return m_cliques1; }
+  const Array<Array<int> > &GetCliques2(void) const { return m_cliques2; }
 
 private:
-  Array<int> firstedge;
-  int maxinp1,maxinp2;
-  List<Array<int> > m_cliques1, m_cliques2;
-
-  void candtry1 (int stk[], // stack 
-	 bool connected[MAXM][MAXN],
-	 int cand,  // the candidate from NODES1  to be added to CLIQUE	 
-	 int clique1[], int cliqsize1,  // CLIQUE so far in NODES1 
-	 int clique2[], int cliqsize2,  // CLIQUE so far in NODES2 
-	 int sn1, int *sc1, int ec1,   // start NOT1, start CAND1, end CAND1 
-	 int sn2, int sc2, int ec2,   // start NOT2, start CAND2, end CAND2 
-	 int tos,  // top of stack 
-	 int orignode1[],
-	 int orignode2[]
-         );
-  void candtry2 (int stk[], // stack 
-	 bool connected[MAXM][MAXN],
-	 int cand,  // the candidate from NODES2  to be added to CLIQUE 
-	 int clique1[], int cliqsize1,  // CLIQUE so far in NODES1 
-	 int clique2[], int cliqsize2,  // CLIQUE so far in NODES2 
-	 int sn1, int sc1, int ec1,   // start NOT1, start CAND1, end CAND1 
-	 int sn2, int *sc2, int ec2,   // start NOT2, start CAND2, end CAND2 
-	 int tos,  // top of stack 
-	 int orignode1[MAXM],
-	 int orignode2[MAXN]);
-  void extend (int stk[], // stack 
-       bool connected[MAXM][MAXN],
-       int clique1[], int cliqsize1,  // CLIQUE so far in NODES1 
-       int clique2[], int cliqsize2,  // CLIQUE so far in NODES2 
-       int sn1, int sc1, int ec1,   // start NOT1, start CAND1, end CAND1 
-       int sn2, int sc2, int ec2,   // start NOT2, start CAND2, end CAND2 
-       int tos,   // top of stack,   tos >= ec1, ec2  
-       int orignode1[MAXM],   // original node numbers as input 
-       int orignode2[MAXN]);
-  void findfixpoint(int stk[], // stack 
-	    bool connected[MAXM][MAXN],
-	    int *savelist,      // position of savelist on the stack 
-	    int *tmplist,       // position of tmplist on the stack 
-	    int *minnod,        // currently lowest no. of disconnections 
-	    int sninspect, int ecinspect,
-	    int scother, int ecother,
-	    bool binspect1,  // inspected nodes are in class1, o/w class2 
-	    bool *bfound,  // a new lower no. of disconnections was found 
-	    int *fixp,     // the new fixpoint, if *bfound = true  
-	    int *posfix);    // position of fixpoint on the stack, if *bfound 
-
-  void genincidence(int e,
-		    Array<Edge> &edgelist,
-		    int orignode1[MAXM],
-		    int orignode2[MAXN],
-		    bool connected[MAXM][MAXN],
-		    int *m,
-		    int *n);
-  int getconnco(Array<int> &firstedge,
-		Array<Edge> &edgelist);
-  void outCLIQUE(int clique1[], int cliqsize1, 
-		 int clique2[], int cliqsize2,
-		 int orignode1[MAXM],
-		 int orignode2[MAXN]);
-  void workonco(int numco,
-		Array<int> &firstedge,
-		Array<Edge> &edgelist);
-
+  Array<Array<int> > m_cliques1, m_cliques2;
 };
 
 } // end namespace Gambit::Nash
 } // end namespace Gambit
 
 #endif // GAMBIT_ENUMMIXED_CLIQUE_H
-
-
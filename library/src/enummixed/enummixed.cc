@@ -20,7 +20,11 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <vector>
+#include <cmath>
+
 #include "gambit/gambit.h"
+#include "gambit/bimatrix.h"
 #include "gambit/linalg/vertenum.imp"
 #include "gambit/nash/enummixed.h"
 #include "clique.h"
@@ -30,42 +34,143 @@ namespace Nash {
 
 using namespace Gambit::linalg;
 
-template <class T> List<List<MixedStrategyProfile<T> > > 
-EnumMixedStrategySolution<T>::GetCliques(void) const
+namespace {
+
+//
+// A value is "large" if the product of any two large values is certainly
+// not zero in the sense of EqZero.  For double, EqZero allows 1e-15, and
+// (1e-7)^2 = 1e-14 is safely outside that; in exact arithmetic every
+// nonzero value is large.
+//
+inline bool IsLarge(double x)           { return (std::fabs(x) > 1.0e-7); }
+inline bool IsLarge(const Rational &x)  { return (x != Rational(0)); }
+
+inline bool IsNonZero(double x)           { return (x != 0.0); }
+inline bool IsNonZero(const Rational &x)  { return (x != Rational(0)); }
+
+//
+// The vertices of one of the two polytopes, with the values of the
+// labels 0, ..., n1+n2-1 of each vertex laid out in arrays, and the sets
+// of labels with nonzero and large values packed into bitmasks.  For
+// a vertex of player 1's polytope, labels 0..n1-1 are the slacks on player
+// 1's strategies, and n1..n1+n2-1 are player 2's strategies.  For a
+// vertex of player 2's polytope, the labels are player 1's strategies
+// and then the slacks on player 2's strategies.  A pair of vertices is
+// then complementary exactly when no label has a nonzero product.
+//
+template <class T> class LabelledVertices {
+public:
+  LabelledVertices(const List<BFS<T> > &p_vertices, int p_n1, int p_n2,
+		   int p_sign);
+
+  int NumWords(void) const { return m_numWords; }
+  int NumLabels(void) const { return m_numLabels; }
+  const unsigned long *NonZero(int v) const 
+  { return &m_nonzero[(v-1) * m_numWords]; }
+  const unsigned long *Large(int v) const 
+  { return &m_large[(v-1) * m_numWords]; }
+  const T *Values(int v) const { return &m_values[(v-1) * m_numLabels]; }
+
+private:
+  int m_numLabels, m_numWords;
+  std::vector<unsigned long> m_nonzero, m_large;
+  std::vector<T> m_values;
+};
+
+const int c_wordBits = 8 * sizeof(unsigned long);
+
+template <class T>
+LabelledVertices<T>::LabelledVertices(const List<BFS<T> > &p_vertices,
+				      int p_n1, int p_n2, int p_sign)
+  : m_numLabels(p_n1 + p_n2),
+    m_numWords((p_n1 + p_n2 + c_wordBits - 1) / c_wordBits),
+    m_nonzero(p_vertices.Length() * m_numWords, 0ul),
+    m_large(p_vertices.Length() * m_numWords, 0ul),
+    m_values(p_vertices.Length() * m_numLabels, T(0))
 {
-  if (m_cliques1.size() == 0) {
-    // Cliques are generated on demand
-    int n = m_node1.Length();
-    if (m_node2.Length() != n)  throw DimensionException();
-
-    Array<CliqueEnumerator::Edge> edgelist(n);
-    for (int i = 1; i <= n; i++) {
-      edgelist[i].node1 = m_node1[i];
-      edgelist[i].node2 = m_node2[i];
+  int v = 1;
+  for (typename List<BFS<T> >::const_iterator vertex = p_vertices.begin();
+       vertex != p_vertices.end(); ++vertex, v++) {
+    unsigned long *nonzero = &m_nonzero[(v-1) * m_numWords];
+    unsigned long *large = &m_large[(v-1) * m_numWords];
+    T *values = &m_values[(v-1) * m_numLabels];
+    for (int l = 0; l < m_numLabels; l++) {
+      int key = (l < p_n1) ? p_sign * (l + 1) : -p_sign * (l - p_n1 + 1);
+      if (!(*vertex).count(key))  continue;
+      values[l] = (*vertex)[key];
+      unsigned long bit = 1ul << (l % c_wordBits);
+      if (IsNonZero(values[l]))  nonzero[l / c_wordBits] |= bit;
+      if (IsLarge(values[l]))    large[l / c_wordBits] |= bit;
     }
+  }
+}
+
+}  // end anonymous namespace
+
+
+template <class T> void EnumMixedStrategySolution<T>::FindCliques(void) const
+{
+  int n = m_node1.Length();
+  if (m_node2.Length() != n)  throw DimensionException();
+
+  Array<CliqueEnumerator::Edge> edgelist(n);
+  int i = 1;
+  for (List<int>::const_iterator node1 = m_node1.begin(), node2 = m_node2.begin();
+       node1 != m_node1.end(); ++node1, ++node2, i++) {
+    edgelist[i] = CliqueEnumerator::Edge(*node1, *node2);
+  }
+
+  CliqueEnumerator clique(edgelist, m_numThreads);
+  m_cliques1 = clique.GetCliques1();
+  m_cliques2 = clique.GetCliques2();
+  m_haveCliques = true;
+}
+
+template <class T> int EnumMixedStrategySolution<T>::NumCliques(void) const
+{
+  if (!m_haveCliques)  FindCliques();
+  return m_cliques1.Length();
+}
+
+template <class T> const Array<int> &
+EnumMixedStrategySolution<T>::GetClique(int p_clique, int p_player) const
+{
+  if (!m_haveCliques)  FindCliques();
+  switch (p_player) {
+  case 1:  return m_cliques1[p_clique];
+  case 2:  return m_cliques2[p_clique];
+  default:  throw IndexException();
+  }
+}
 
-    CliqueEnumerator clique(edgelist, m_v2+1, m_v1+1);
-    m_cliques1 = clique.GetCliques1();
-    m_cliques2 = clique.GetCliques2();
+template <class T> MixedStrategyProfile<T>
+EnumMixedStrategySolution<T>::GetExtremeProfile(int p_index1,
+						int p_index2) const
+{
+  const Vector<T> &key1 = m_key1[p_index1], &key2 = m_key2[p_index2];
+  MixedStrategyProfile<T> profile(m_game->NewMixedStrategyProfile(static_cast<T>(0)));
+  for (int k = 1; k <= key1.Length(); k++) {
+    profile[k] = key1[k];
   }
+  for (int k = 1; k <= key2.Length(); k++) {
+    profile[k + key1.Length()] = key2[k];
+  }
+  return profile;
+}
 
+template <class T> List<List<MixedStrategyProfile<T> > > 
+EnumMixedStrategySolution<T>::GetCliques(void) const
+{
   List<List<MixedStrategyProfile<T> > > solution;
-  for (int cl = 1; cl <= m_cliques1.Length(); cl++) {
-    solution.push_back(List<MixedStrategyProfile<T> >());
-    for (int i = 1; i <= m_cliques1[cl].Length(); i++) {
-      for (int j = 1; j <= m_cliques2[cl].Length(); j++) {
-	MixedStrategyProfile<T> profile(m_game->NewMixedStrategyProfile(static_cast<T>(0)));
-
-	for (int k = 1; k <= m_key1[m_cliques1[cl][i]].Length(); k++) {
-	  profile[k] = m_key1[m_cliques1[cl][i]][k];
-	}
-	for (int k = 1; k <= m_key2[m_cliques2[cl][j]].Length(); k++) {
-	  profile[k + m_key1[m_cliques1[cl][i]].Length()] =
-	    m_key2[m_cliques2[cl][j]][k];
-	}
-	solution[cl].push_back(profile);
+  for (int cl = 1; cl <= NumCliques(); cl++) {
+    const Array<int> &clique1 = GetClique(cl, 1), &clique2 = GetClique(cl, 2);
+    List<MixedStrategyProfile<T> > profiles;
+    for (int i = 1; i <= clique1.Length(); i++) {
+      for (int j = 1; j <= clique2.Length(); j++) {
+	profiles.push_back(GetExtremeProfile(clique1[i], clique2[j]));
       }
     }
+    solution.push_back(profiles);
   }
   return solution;
 }
@@ -79,17 +184,19 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   if (!p_game->IsPerfectRecall()) {
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
+  IntegerArena arena;
   shared_ptr<EnumMixedStrategySolution<T> > solution = new EnumMixedStrategySolution<T>(p_game);
+  solution->m_numThreads = m_numThreads;
 
-  PureStrategyProfile profile = p_game->NewPureStrategyProfile();
+  BimatrixGame bimatrix(p_game);
 
-  Rational min = p_game->GetMinPayoff();
+  Rational min = bimatrix.GetMinPayoff();
   if (min > Rational(0)) {
     min = Rational(0);
   }
   min -= Rational(1);
 
-  Rational max = p_game->GetMaxPayoff();
+  Rational max = bimatrix.GetMaxPayoff();
   if (max < Rational(0)) {
     max = Rational(0);
   }
@@ -97,19 +204,10 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   Rational fac(1, max - min);
 
   // Construct matrices A1, A2
-  Matrix<T> A1(1, p_game->Players()[1]->Strategies().size(),
-	       1, p_game->Players()[2]->Strategies().size());
-  Matrix<T> A2(1, p_game->Players()[2]->Strategies().size(),
-	       1, p_game->Players()[1]->Strategies().size());
-
-  for (size_t i = 1; i <= p_game->Players()[1]->Strategies().size(); i++) {
-    profile->SetStrategy(p_game->Players()[1]->Strategies()[i]);
-    for (size_t j = 1; j <= p_game->Players()[2]->Strategies().size(); j++) {
-      profile->SetStrategy(p_game->Players()[2]->Strategies()[j]);
-      A1(i, j) = fac * (profile->GetPayoff(1) - min);
-      A2(j, i) = fac * (profile->GetPayoff(2) - min);
-    }
-  }
+  Matrix<T> A1(1, bimatrix.NumRows(), 1, bimatrix.NumCols());
+  Matrix<T> A2(1, bimatrix.NumCols(), 1, bimatrix.NumRows());
+  bimatrix.GetScaledPayoffs(1, min, fac, A1, 0, 0, false);
+  bimatrix.GetScaledPayoffs(2, min, fac, A2, 0, 0, true);
 
   // Construct vectors b1, b2
   Vector<T> b1(1, p_game->Players()[1]->Strategies().size());
@@ -117,12 +215,54 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   b1 = (T) -1;
   b2 = (T) -1;
 
-  // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0
-  VertexEnumerator<T> poly1(A1, b1);
-  VertexEnumerator<T> poly2(A2, b2);
+  // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0.
+  // With several threads, the two polytopes are enumerated concurrently,
+  // and each enumeration spreads its own search over the same threads.
+  VertexEnumerator<T> *poly1 = 0, *poly2 = 0;
+  std::string error;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(m_numThreads) if (m_numThreads > 1)
+#endif  // _OPENMP
+  {
+    IntegerArena threadArena;
+#ifdef _OPENMP
+#pragma omp single
+#endif  // _OPENMP
+    {
+#ifdef _OPENMP
+#pragma omp task
+#endif  // _OPENMP
+      try {
+	poly1 = new VertexEnumerator<T>(A1, b1, m_numThreads, m_splitDepth);
+      }
+      catch (std::exception &e) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_enummixed_error)
+#endif  // _OPENMP
+	error = e.what();
+      }
+#ifdef _OPENMP
+#pragma omp task
+#endif  // _OPENMP
+      try {
+	poly2 = new VertexEnumerator<T>(A2, b2, m_numThreads, m_splitDepth);
+      }
+      catch (std::exception &e) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_enummixed_error)
+#endif  // _OPENMP
+	error = e.what();
+      }
+    }
+  }
+  if (!error.empty()) {
+    delete poly1;
+    delete poly2;
+    throw Exception(error);
+  }
 
-  const List<BFS<T> > &verts1(poly1.VertexList());
-  const List<BFS<T> > &verts2(poly2.VertexList());
+  const List<BFS<T> > &verts1(poly1->VertexList());
+  const List<BFS<T> > &verts2(poly2->VertexList());
   solution->m_v1 = verts1.Length();
   solution->m_v2 = verts2.Length();
 
@@ -131,66 +271,89 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   for (int i = 1; i <= vert1id.Length(); vert1id[i++] = 0);
   for (int i = 1; i <= vert2id.Length(); vert2id[i++] = 0);
 
-  int i = 0;
-  int id1 = 0, id2 = 0;
+  int n1 = p_game->Players()[1]->Strategies().size();
+  int n2 = p_game->Players()[2]->Strategies().size();
+  LabelledVertices<T> labels1(verts1, n1, n2, -1);
+  LabelledVertices<T> labels2(verts2, n1, n2, 1);
 
+  // Find the complementary pairs.  Vertex 1 of each polytope is the
+  // origin, which is not part of any equilibrium.  Each row of pairs is
+  // independent of the others, so rows are shared out among threads;
+  // profiles are then built serially, in the original order.
+  int words = labels1.NumWords();
+  std::vector<std::vector<int> > partners(solution->m_v2 + 1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 8) num_threads(m_numThreads) if (m_numThreads > 1 && (long) solution->m_v1 * solution->m_v2 > 10000)
+#endif  // _OPENMP
   for (int i2 = 2; i2 <= solution->m_v2; i2++) {
-    BFS<T> bfs1 = verts2[i2];
-    i++;
+    const unsigned long *nonzero2 = labels2.NonZero(i2);
+    const unsigned long *large2 = labels2.Large(i2);
     for (int i1 = 2; i1 <= solution->m_v1; i1++) {
-      BFS<T> bfs2 = verts1[i1];
-	
-      // check if solution is nash 
-      // need only check complementarity, since it is feasible
-      bool nash = true;
-      for (size_t k = 1; nash && k <= p_game->Players()[1]->Strategies().size(); k++) {
-	if (bfs1.count(k) && bfs2.count(-k)) {
-	  nash = nash && EqZero(bfs1[k] * bfs2[-k]);
-	}
+      const unsigned long *nonzero1 = labels1.NonZero(i1);
+      const unsigned long *large1 = labels1.Large(i1);
+      bool clash = false, overlap = false;
+      for (int w = 0; w < words; w++) {
+	clash = clash || (large1[w] & large2[w]);
+	overlap = overlap || (nonzero1[w] & nonzero2[w]);
       }
-
-      for (size_t k = 1; nash && k <= p_game->Players()[2]->Strategies().size(); k++) {
-	if (bfs2.count(k) && bfs1.count(-k)) {
-	  nash = nash && EqZero(bfs2[k] * bfs1[-k]);
+      if (clash)  continue;
+      if (overlap) {
+	// Some product is small but nonzero; decide using EqZero
+	const T *values1 = labels1.Values(i1), *values2 = labels2.Values(i2);
+	bool nash = true;
+	for (int l = 0; nash && l < labels1.NumLabels(); l++) {
+	  nash = EqZero(values1[l] * values2[l]);
 	}
+	if (!nash)  continue;
       }
+      partners[i2].push_back(i1);
+    }
+  }
 
-      if (nash) {
-	MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0)));
-	static_cast<Vector<T> &>(profile) = static_cast<T>(0);
-	for (size_t k = 1; k <= p_game->Players()[1]->Strategies().size(); k++) {
-	  if (bfs1.count(k)) {
-	    profile[p_game->Players()[1]->Strategies()[k]] = -bfs1[k];
-	  }
-	} 
-	for (size_t k = 1; k <= p_game->Players()[2]->Strategies().size(); k++) {
-	  if (bfs2.count(k)) {
-	    profile[p_game->Players()[2]->Strategies()[k]] = -bfs2[k];
-	  }
-	} 
-	profile.Normalize();
-	solution->m_extremeEquilibria.push_back(profile);
-	this->m_onEquilibrium->Render(profile);
-	  
-	// note: The keys give the mixed strategy associated with each node. 
-	//       The keys should also keep track of the basis
-	//       As things stand now, two different bases could lead to
-	//       the same key... BAD!
-	if (vert1id[i1] == 0) {
-	  id1++;
-	  vert1id[i1] = id1;
-	  solution->m_key2.push_back(profile[p_game->GetPlayer(2)]);
+  int id1 = 0, id2 = 0;
+
+  for (int i2 = 2; i2 <= solution->m_v2; i2++) {
+    for (size_t p = 0; p < partners[i2].size(); p++) {
+      int i1 = partners[i2][p];
+      const BFS<T> &bfs1 = verts2[i2];
+      const BFS<T> &bfs2 = verts1[i1];
+
+      MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0)));
+      static_cast<Vector<T> &>(profile) = static_cast<T>(0);
+      for (int k = 1; k <= n1; k++) {
+	if (bfs1.count(k)) {
+	  profile[p_game->Players()[1]->Strategies()[k]] = -bfs1[k];
 	}
-	if (vert2id[i2] == 0) {
-	  id2++;
-	  vert2id[i2] = id2;
-	  solution->m_key1.push_back(profile[p_game->GetPlayer(1)]);
+      } 
+      for (int k = 1; k <= n2; k++) {
+	if (bfs2.count(k)) {
+	  profile[p_game->Players()[2]->Strategies()[k]] = -bfs2[k];
 	}
-	solution->m_node1.Append(vert2id[i2]);
-	solution->m_node2.Append(vert1id[i1]);
+      } 
+      profile.Normalize();
+      solution->m_extremeEquilibria.push_back(profile);
+      this->m_onEquilibrium->Render(profile);
+	  
+      // note: The keys give the mixed strategy associated with each node. 
+      //       The keys should also keep track of the basis
+      //       As things stand now, two different bases could lead to
+      //       the same key... BAD!
+      if (vert1id[i1] == 0) {
+	id1++;
+	vert1id[i1] = id1;
+	solution->m_key2.push_back(profile[p_game->GetPlayer(2)]);
+      }
+      if (vert2id[i2] == 0) {
+	id2++;
+	vert2id[i2] = id2;
+	solution->m_key1.push_back(profile[p_game->GetPlayer(1)]);
       }
+      solution->m_node1.Append(vert2id[i2]);
+      solution->m_node2.Append(vert1id[i1]);
     }
   }
+  delete poly1;
+  delete poly2;
   return solution;
 }
 
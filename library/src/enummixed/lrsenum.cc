@@ -40,6 +40,7 @@
 #include <iostream>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 // The order of these next includes is important, because of macro definitions
 #include "gambit/gambit.h"
@@ -58,8 +59,49 @@ namespace Nash {
 // rather than as private member functions of the solver class.
 namespace {
 
+//
+// The search over player 2's polytope is repeated for each vertex of
+// player 1's polytope.  Each search starts from the dictionary saved in
+// P2orig by the previous one, and only pivots out the linearities which
+// differ.  A separate instance is needed for each thread searching.
+//
+class Player2Search {
+public:
+  lrs_dat *Q2;
+  lrs_dic *P2;          /* dictionary as built from the game                 */
+  lrs_dic *P2orig;      /* dictionary saved in getabasis2                    */
+  lrs_mp_vector output2;
+  long *linindex;       /* NULL until the first call to getabasis2           */
+  long firstwarning;    /* FALSE if dual deg warning for Q2 already given    */
+  long firstunbounded;  /* FALSE if unbounded warning for Q2 already given   */
+
+  Player2Search(lrs_dat *p_Q2, lrs_dic *p_P2);
+  ~Player2Search();
+};
+
+Player2Search::Player2Search(lrs_dat *p_Q2, lrs_dic *p_P2)
+  : Q2(p_Q2), P2(p_P2), P2orig(0), output2(0), linindex(0),
+    firstwarning(TRUE), firstunbounded(TRUE)
+{
+  P2orig = lrs_getdic(Q2);  	     /* allocate and initialize lrs_dic                     */
+  if (P2orig == NULL) {
+    throw Exception("Error in allocating lrslib data");
+  }
+  copy_dict(Q2, P2orig, P2);
+  output2 = lrs_alloc_mp_vector(Q2->n + Q2->m);   /* output holds one line of output from dictionary     */
+}
+
+Player2Search::~Player2Search()
+{
+  lrs_clear_mp_vector(output2, Q2->m + Q2->n);
+  free(linindex);
+  Q2->Qhead = P2orig;
+  lrs_free_dic(P2orig, Q2);
+  Q2->Qhead = P2;          /* reset this or you crash free_dic */
+}
+
 long 
-getabasis2 (lrs_dic * P, lrs_dat * Q, lrs_dic * P2orig, long order[])
+getabasis2 (lrs_dic * P, lrs_dat * Q, Player2Search * S, long order[])
 
 /* Pivot Ax<=b to standard form */
 /*Try to find a starting basis by pivoting in the variables x[1]..x[d]        */
@@ -83,20 +125,20 @@ getabasis2 (lrs_dic * P, lrs_dat * Q, lrs_dic * P2orig, long order[])
   long m, d, nlinearity;
   long nredundcol = 0L;		/* will be calculated here */
 
-  static long firsttime=TRUE;
-  static long *linindex;
+  long *linindex;
+  lrs_dic *P2orig = S->P2orig;
 
   m = P->m;
   d = P->d;
   nlinearity = Q->nlinearity;
 
-  if(firsttime)
+  if(!S->linindex)
   {
-    firsttime = FALSE;
-    linindex = (long int *) calloc ((m + d + 2), sizeof (long));
+    S->linindex = linindex = (long int *) calloc ((m + d + 2), sizeof (long));
   }
   else     /* after first time we update the change in linearities from the last time, saving many pivots */
   {
+    linindex = S->linindex;
     for(i=1;i<=m+d;i++)
 	  linindex[i]=FALSE;
     if(Q->debug)
@@ -125,6 +167,14 @@ getabasis2 (lrs_dic * P, lrs_dat * Q, lrs_dic * P2orig, long order[])
 	            pivot (P, Q, j, k);
 		    update (P, Q, &j, &k);
                    }
+		   else if (!zero (A[Row[i]][0]))
+                     {
+                       /* the linearity is fixed by the others at a nonzero value: */
+                       /* there is no solution.  The saved dictionary is untouched */
+                       if(Q->debug || Q->verbose)
+		          fprintf(lrs_ofp,"\n*Inconsistent linearity i=%ld B[i]=%ld",i,B[i]);
+                       return FALSE;
+                     }
 		   else
                      if(Q->debug || Q->verbose)
 		        fprintf(lrs_ofp,"\n*Couldn't remove linearity i=%ld B[i]=%ld",i,B[i]);		   
@@ -276,7 +326,7 @@ hotstart:
 #define D (*D_p)
 
 long 
-lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix * Lin, long no_output)
+lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, Player2Search * S, lrs_mp_matrix * Lin, long no_output)
 /* gets first basis, FALSE if none              */
 /* P may get changed if lin. space Lin found    */
 /* no_output is TRUE supresses output headers   */
@@ -292,7 +342,7 @@ lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix
   long hull = Q->hull;
   long m, d, lastdv, nlinearity, nredundcol;
 
-  static long ocount=0;
+  long ocount=0;
 
 
   m = D->m;
@@ -351,7 +401,7 @@ lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix
 /* The inequality array is used to give the insertion order                   */
 /* and is defaulted to the last d rows when givenstart=FALSE                  */
 
-  if (!getabasis2 (D, Q,P2orig, inequality))
+  if (!getabasis2 (D, Q, S, inequality))
           return FALSE;
 
   if(Q->debug)
@@ -550,28 +600,60 @@ Rational to_rational(lrs_mp Nin, lrs_mp Din)
   return lexical_cast<Rational>(ss.str());
 }
 
+Array<Rational> to_rationals(lrs_mp_vector output, long n)
+{
+  Array<Rational> x(n);
+  for (long i = 1; i <= n; i++) {
+    x[i] = to_rational(output[i], output[0]);
+  }
+  return x;
+}
+
 MixedStrategyProfile<Rational>
 BuildProfile(const Game &p_game,
-	     lrs_dat *Q1, lrs_mp_vector output1,
-	     lrs_dat *Q2, lrs_mp_vector output2)
+	     const Array<Rational> &p_vertex1, const Array<Rational> &p_vertex2)
 {
   MixedStrategyProfile<Rational> profile =
     p_game->NewMixedStrategyProfile(Rational(0));
   
-  long i = 1;
   GamePlayer player1 = p_game->Players()[1];
   for (int j = 1; j <= player1->NumStrategies(); j++) {
-    profile[player1->GetStrategy(j)] = to_rational(output1[i++], output1[0]);
+    profile[player1->GetStrategy(j)] = p_vertex1[j];
   }
 
-  i = 1;
   GamePlayer player2 = p_game->Players()[2];
   for (int j = 1; j <= player2->NumStrategies(); j++) {
-    profile[player2->GetStrategy(j)] = to_rational(output2[i++], output2[0]); 
+    profile[player2->GetStrategy(j)] = p_vertex2[j];
   }
   return profile;
 }
 
+/* Here we take the linearities generated by the current vertex of player 1*/
+/* which are to be appended to the linearity in player 2's input matrix    */ 
+/* next is the key magic linking player 1 and 2 */
+/* be careful if you mess with this!            */
+std::vector<long> player2_linearities(lrs_dic *P1, lrs_dat *Q1)
+{
+  std::vector<long> linearity;
+  long i, j;
+
+  for (i = Q1->lastdv+1; i <= P1->m; i++) {
+    if (!zero(P1->A[P1->Row[i]][0])) {
+      j =  Q1->inequality[P1->B[i]-Q1->lastdv];
+      if (j < Q1->linearity[0]) {
+	linearity.push_back(j);
+      }
+    }
+  }
+  /* add back in the linearity for probs summing to one */
+  linearity.push_back(Q1->linearity[0]);
+
+  /* sort linearities */
+  for (i = 1; i < (long) linearity.size(); i++) {
+    reorder(&linearity[0], linearity.size());
+  }
+  return linearity;
+}
 
 
 /**********************************************************/
@@ -579,54 +661,25 @@ BuildProfile(const Game &p_game,
 /* equilibria on a second polytope interleaved with first */
 /**********************************************************/
 
-long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig, 
-		 lrs_dat *Q2, 
-		 lrs_mp_vector output1, lrs_mp_vector output2,
-		 const Game &p_game,
-		 List<MixedStrategyProfile<Rational> > &p_equilibria,
-		 shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium)
+long nash2_main (const std::vector<long> &p_linearity, Player2Search *S,
+		 List<Array<Rational> > &p_vertices)
 
 
 {
-
+  lrs_dat *Q2 = S->Q2;
   lrs_dic *P2;                  /* This can get resized, cached etc. Loaded from P2orig */
   lrs_mp_matrix Lin;		/* holds input linearities if any are found             */
   long col;			/* output column index for dictionary                   */
   long startcol = 0;
   long prune = FALSE;		/* if TRUE, getnextbasis will prune tree and backtrack  */
-  long nlinearity;
-  long *linearity;
-  static long firstwarning=TRUE;    /* FALSE if dual deg warning for Q2 already given     */
-  static long firstunbounded=TRUE;  /* FALSE if dual deg warning for Q2 already given     */
-
-  long i,j;
 
   P2=lrs_getdic(Q2);
-  copy_dict(Q2,P2,P2orig);
+  copy_dict(Q2,P2,S->P2orig);
 
-/* Here we take the linearities generated by the current vertex of player 1*/
-/* and append them to the linearity in player 2's input matrix             */ 
-/* next is the key magic linking player 1 and 2 */
-/* be careful if you mess with this!            */
-  linearity = Q2->linearity;
-  nlinearity = 0;
-  for (i = Q1->lastdv+1; i <= P1->m; i++) {
-    if (!zero(P1->A[P1->Row[i]][0])) {
-      j =  Q1->inequality[P1->B[i]-Q1->lastdv];
-      if (j < Q1->linearity[0]) {
-	linearity[nlinearity++]= j;
-      }
-    }
-  }
-  /* add back in the linearity for probs summing to one */
-  linearity[nlinearity++] = Q1->linearity[0];
-
-  /* sort linearities */
-  for (i = 1; i < nlinearity; i++) {
-    reorder(linearity, nlinearity);
+  for (size_t i = 0; i < p_linearity.size(); i++) {
+    Q2->linearity[i] = p_linearity[i];
   }
-
-  Q2->nlinearity = nlinearity;
+  Q2->nlinearity = p_linearity.size();
   Q2->polytope = FALSE;
 
   // Step 2: Find a starting cobasis from default of specified order
@@ -634,16 +687,16 @@ long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
   //         Lin is created if necessary to hold linearity space
   //         Print linearity space if any, and retrieve output from first
   //         dict.
-  if (!lrs_getfirstbasis2 (&P2, Q2, P2orig, &Lin, TRUE)) {
+  if (!lrs_getfirstbasis2 (&P2, Q2, S, &Lin, TRUE)) {
     goto sayonara;
   }
-  if (firstwarning && Q2->dualdeg) {
-    firstwarning=FALSE;
+  if (S->firstwarning && Q2->dualdeg) {
+    S->firstwarning=FALSE;
     printf("\n*Warning! Dual degenerate, ouput may be incomplete");
     printf("\n*Recommendation: Add dualperturb option before maximize in second input file\n");
   }
-  if (firstunbounded && Q2->unbounded) {
-    firstunbounded=FALSE;
+  if (S->firstunbounded && Q2->unbounded) {
+    S->firstunbounded=FALSE;
     printf("\n*Warning! Unbounded starting dictionary for p2, output may be incomplete");
     printf("\n*Recommendation: Change/remove maximize option, or include bounds \n");
   }
@@ -670,9 +723,8 @@ long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
   do  {
     prune = lrs_checkbound(P2, Q2);
     col = 0;
-    if (!prune && lrs_getsolution(P2, Q2, output2, col)) {
-      p_equilibria.push_back(BuildProfile(p_game, Q1, output1, Q2, output2));
-      p_onEquilibrium->Render(p_equilibria.back()); 
+    if (!prune && lrs_getsolution(P2, Q2, S->output2, col)) {
+      p_vertices.push_back(to_rationals(S->output2, Q2->n - 2));
     }
   } while (lrs_getnextbasis(&P2, Q2, prune));
 
@@ -685,6 +737,15 @@ sayonara:
 /* end of nash2_main                          */
 /*********************************************/
 
+//
+// The work done for one vertex of player 1's polytope
+//
+struct Player1Vertex {
+  std::vector<long> linearity;
+  Array<Rational> vertex1;
+  List<Array<Rational> > vertices2;
+};
+
 }  // end anonymous namespace
 
 
@@ -876,11 +937,8 @@ EnumMixedLrsStrategySolver::Solve(const Game &p_game) const
   }
   
   lrs_mp_vector output1; /* holds one line of output; ray,vertex,facet,linearity */
-  lrs_mp_vector output2; /* holds one line of output; ray,vertex,facet,linearity */
   lrs_mp_matrix Lin;	/* holds input linearities if any are found             */
 
-  lrs_dic *P2orig;  /* we will save player 2's dictionary in getabasis      */
-
   long col;	    /* output column index for dictionary                   */
   long startcol = 0;
   long prune = FALSE;		/* if TRUE, getnextbasis will prune tree and backtrack  */
@@ -891,13 +949,9 @@ EnumMixedLrsStrategySolver::Solve(const Game &p_game) const
   LrsData data(p_game);
 
   output1 = lrs_alloc_mp_vector(data.Q1->n + data.Q1->m);   /* output holds one line of output from dictionary     */
-  output2 = lrs_alloc_mp_vector (data.Q2->n + data.Q2->m);   /* output holds one line of output from dictionary     */
 
-  P2orig = lrs_getdic(data.Q2);  	     /* allocate and initialize lrs_dic                     */
-  if (P2orig == NULL) {
-    throw Exception("Error in allocating lrslib data");
-  }
-  copy_dict(data.Q2,P2orig,data.P2);
+  /* we will save player 2's dictionary in getabasis      */
+  Player2Search search(data.Q2, data.P2);
 
   // Step 2: Find a starting cobasis from default of specified order
   //         P1 is created to hold  active dictionary data and may be cached
@@ -943,6 +997,14 @@ EnumMixedLrsStrategySolver::Solve(const Game &p_game) const
   /* User can access each output line from output which is */
   /* vertex/ray/facet from the lrs_mp_vector output         */
   /* prune is TRUE if tree should be pruned at current node */
+  //
+  // With one thread, the search on player 2's polytope for each vertex
+  // of player 1 is done as the vertex is found.  With several, the
+  // vertices of player 1 are collected first, and then divided into
+  // consecutive blocks, one for each thread.  Consecutive vertices are
+  // adjacent, so each search after the first in a block needs few pivots.
+  //
+  std::vector<Player1Vertex> vertices;
   do {
     // FIXME: In some circumstances, especially the Python extension,
     // this algorithm runs very slowly.  However, adding any sort
@@ -950,16 +1012,82 @@ EnumMixedLrsStrategySolver::Solve(const Game &p_game) const
     // This needs to be chased up further.
     prune = lrs_checkbound(data.P1, data.Q1);
     if (!prune && lrs_getsolution(data.P1, data.Q1, output1, col)) {
-      nash2_main(data.P1,data.Q1,P2orig,data.Q2,output1,output2,p_game,
-		 equilibria, m_onEquilibrium);
+      Player1Vertex vertex;
+      vertex.linearity = player2_linearities(data.P1, data.Q1);
+      vertex.vertex1 = to_rationals(output1, data.Q1->n - 2);
+      if (m_numThreads > 1) {
+	vertices.push_back(vertex);
+	continue;
+      }
+      nash2_main(vertex.linearity, &search, vertex.vertices2);
+      for (int i = 1; i <= vertex.vertices2.Length(); i++) {
+	equilibria.push_back(BuildProfile(p_game, vertex.vertex1,
+					  vertex.vertices2[i]));
+	m_onEquilibrium->Render(equilibria.back()); 
+      }
     }
   } while (lrs_getnextbasis(&data.P1, data.Q1, prune));
 
   lrs_clear_mp_vector(output1, data.Q1->m + data.Q1->n);
-  lrs_clear_mp_vector(output2, data.Q2->m + data.Q2->n);
-  
-  data.Q2->Qhead = data.P2;          /* reset this or you crash free_dic */
 
+  if (vertices.empty()) {
+    return equilibria;
+  }
+
+  std::string error;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(m_numThreads)
+#endif  // _OPENMP
+  {
+    IntegerArena threadArena;
+    // Each thread initializes lrslib and builds its own copy of the
+    // problem; the game is only read by one thread at a time.
+    LrsData *threadData = 0;
+    Player2Search *threadSearch = 0;
+#ifdef _OPENMP
+#pragma omp critical(gambit_lrsenum_game)
+#endif  // _OPENMP
+    try {
+      threadData = new LrsData(p_game);
+      threadSearch = new Player2Search(threadData->Q2, threadData->P2);
+    }
+    catch (std::exception &e) {
+      error = e.what();
+    }
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif  // _OPENMP
+    for (int i = 0; i < (int) vertices.size(); i++) {
+      if (!threadSearch) {
+	continue;
+      }
+      try {
+	nash2_main(vertices[i].linearity, threadSearch,
+		   vertices[i].vertices2);
+      }
+      catch (std::exception &e) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_lrsenum_error)
+#endif  // _OPENMP
+	error = e.what();
+      }
+    }
+
+    delete threadSearch;
+    delete threadData;
+  }
+  if (!error.empty()) {
+    throw Exception(error);
+  }
+
+  for (size_t v = 0; v < vertices.size(); v++) {
+    for (int i = 1; i <= vertices[v].vertices2.Length(); i++) {
+      equilibria.push_back(BuildProfile(p_game, vertices[v].vertex1,
+					vertices[v].vertices2[i]));
+      m_onEquilibrium->Render(equilibria.back()); 
+    }
+  }
   return equilibria;
 }
 
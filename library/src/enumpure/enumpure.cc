@@ -0,0 +1,152 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/enumpure/enumpure.cc
+// Enumerate pure-strategy Nash equilibria of a game
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "gambit/gambit.h"
+#include "gambit/gametable.h"
+#include "gambit/nash/enumpure.h"
+
+namespace Gambit {
+namespace Nash {
+
+namespace {
+
+//
+// Strikes out the contingencies that are not best responses for a player,
+// on the lines of the table visited by an iterator.  Each contingency
+// visited is the base of a line, along which only the player's strategy
+// varies.  The best payoff on the line is found in floating point, and
+// contingencies short of it by more than a small tolerance are struck
+// out, so that no equilibrium is struck out by rounding; a comparison
+// with a payoff which is not finite never strikes out a contingency.
+// Lines do not overlap, so separate ranges may be done concurrently.
+//
+class StrikeOut {
+public:
+  StrikeOut(const GameTableRep &p_table, int p_player,
+	    const Array<long> &p_offsets, std::vector<char> &p_candidate)
+    : m_table(p_table), m_player(p_player), m_offsets(p_offsets),
+      m_candidate(p_candidate) { }
+
+  void operator()(int, ContingencyIterator &p_iter) const
+  {
+    for (; !p_iter.AtEnd(); p_iter++) {
+      long base = p_iter.GetIndex();
+      double best = m_table.GetPayoff<double>(base + m_offsets[1], m_player);
+      for (int st = 2; st <= m_offsets.Length(); st++) {
+	best = std::max(best, m_table.GetPayoff<double>(base + m_offsets[st],
+							m_player));
+      }
+      double threshold = best - 1.0e-9 * (1.0 + std::fabs(best));
+      for (int st = 1; st <= m_offsets.Length(); st++) {
+	if (m_table.GetPayoff<double>(base + m_offsets[st], m_player) < threshold) {
+	  m_candidate[base + m_offsets[st]] = 0;
+	}
+      }
+    }
+  }
+
+private:
+  const GameTableRep &m_table;
+  int m_player;
+  const Array<long> &m_offsets;
+  std::vector<char> &m_candidate;
+};
+
+//
+// Scans the payoff table of a strategic game for candidate pure
+// equilibria, striking out for each player in turn the contingencies
+// which are not best responses.  Small tables are done on one thread;
+// larger ones are split into several ranges of lines per thread.
+//
+// The contingencies that remain are returned in increasing order of
+// index, which is the order in which StrategyProfileIterator visits
+// them; they still need to be checked exactly.
+//
+std::vector<long> FindCandidates(const GameTableRep &p_table,
+				 const Array<int> &p_dim, int p_numThreads)
+{
+  long size = p_table.NumContingencies();
+  std::vector<char> candidate(size + 1, 1);
+  int numRanges = (p_numThreads > 1 && size > 10000) ? 8 * p_numThreads : 1;
+  ContingencyIterator::Offsets offsets =
+    ContingencyIterator::TableOffsets(p_dim);
+  for (int pl = 1; pl <= p_dim.Length(); pl++) {
+    ContingencyIterator::Offsets lines(offsets);
+    lines[pl] = Array<long>(1);
+    lines[pl][1] = 0;
+    StrikeOut body(p_table, pl, offsets[pl], candidate);
+    ForEachContingencyRange(lines, numRanges, p_numThreads, body);
+  }
+
+  std::vector<long> candidates;
+  for (long index = 1; index <= size; index++) {
+    if (candidate[index])  candidates.push_back(index);
+  }
+  return candidates;
+}
+
+}  // end anonymous namespace
+
+List<MixedStrategyProfile<Rational> >
+EnumPureStrategySolver::Solve(const Game &p_game) const
+{
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  List<MixedStrategyProfile<Rational> > solutions;
+  const GameTableRep *table =
+    dynamic_cast<const GameTableRep *>(static_cast<GameRep *>(p_game));
+  if (!table) {
+    for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
+      if ((*citer)->IsNash()) {
+	MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
+	m_onEquilibrium->Render(profile);
+	solutions.Append(profile);
+      }
+    }
+    return solutions;
+  }
+
+  Array<int> dim = p_game->NumStrategies();
+  std::vector<long> candidates = FindCandidates(*table, dim, m_numThreads);
+  PureStrategyProfile citer = p_game->NewPureStrategyProfile();
+  for (size_t c = 0; c < candidates.size(); c++) {
+    long index = candidates[c] - 1;
+    for (int pl = 1; pl <= dim.Length(); pl++) {
+      citer->SetStrategy(p_game->GetPlayer(pl)->GetStrategy(index % dim[pl] + 1));
+      index /= dim[pl];
+    }
+    if (citer->IsNash()) {
+      MixedStrategyProfile<Rational> profile = citer->ToMixedStrategyProfile();
+      m_onEquilibrium->Render(profile);
+      solutions.Append(profile);
+    }
+  }
+  return solutions;
+}
+
+}  // end namespace Gambit::Nash
+}  // end namespace Gambit
@@ -31,6 +31,7 @@
 #include <cmath>
 #include "gambit/gambit.h"
 #include "gambit/function.h"
+#include "gambit/kernels.h"
 
 using namespace Gambit;
 
@@ -74,8 +75,9 @@ void
 ConjugatePRMinimizer::AlphaXPlusY(double alpha,
 				  const Vector<double> &x, Vector<double> &y)
 {
-  for (int i = 1; i <= y.Length(); i++) {
-    y[i] += alpha * x[i];
+  if (!x.Check(y))  throw DimensionException();
+  if (y.Length() > 0) {
+    kernels::Axpy(alpha, &x[x.First()], &y[y.First()], y.Length());
   }
 }
 
@@ -178,21 +178,36 @@ Game GameTableRep::Copy(void) const
 
 bool GameTableRep::IsConstSum(void) const
 {
-  TablePureStrategyProfileRep profile(const_cast<GameTableRep *>(this));
+  // The sum of payoffs is the same in all contingencies with the same
+  // outcome, so it is enough to look at each outcome in use once.
+  Array<bool> used(m_outcomes.Length());
+  for (int outc = 1; outc <= used.Length(); used[outc++] = false);
+  bool usesNull = false;
+  for (long index = 1; index <= m_results.Length(); index++) {
+    if (m_results[index]) {
+      used[m_results[index]->GetNumber()] = true;
+    }
+    else {
+      usesNull = true;
+    }
+  }
 
+  bool first = true;
   Rational sum(0);
-  for (int pl = 1; pl <= m_players.Length(); pl++) {
-    sum += profile.GetPayoff(pl);
+  if (usesNull) {
+    first = false;
   }
-
-  for (StrategyProfileIterator iter(StrategySupportProfile(const_cast<GameTableRep *>(this)));
-       !iter.AtEnd(); iter++) {
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    if (!used[outc])  continue;
     Rational newsum(0);
     for (int pl = 1; pl <= m_players.Length(); pl++) {
-      newsum += (*iter)->GetPayoff(pl);
+      newsum += m_outcomes[outc]->GetPayoff<Rational>(pl);
     }
-    
-    if (newsum != sum) {
+    if (first) {
+      sum = newsum;
+      first = false;
+    }
+    else if (newsum != sum) {
       return false;
     }
   }
@@ -350,33 +365,35 @@ MixedStrategyProfile<Rational> GameTableRep::NewMixedStrategyProfile(const Ratio
 /// numbered -1 are identified as the new strategies.
 void GameTableRep::RebuildTable(void)
 {
+  // Contingencies are copied only for strategies already in the old
+  // table; these are matched up by iterating over the same contingencies
+  // with their old and new offsets.
   long size = 1L;
-  Array<long> offsets(m_players.Length());
+  ContingencyIterator::Offsets oldOffsets(m_players.Length());
+  ContingencyIterator::Offsets newOffsets(m_players.Length());
   for (int pl = 1; pl <= m_players.Length(); pl++) {
-    offsets[pl] = size;
-    size *= m_players[pl]->NumStrategies();
+    const Array<GameStrategyRep *> &strategies = m_players[pl]->m_strategies;
+    int numOld = 0;
+    for (int st = 1; st <= strategies.Length(); st++) {
+      if (strategies[st]->m_offset >= 0)  numOld++;
+    }
+    oldOffsets[pl] = Array<long>(numOld);
+    newOffsets[pl] = Array<long>(numOld);
+    for (int st = 1, k = 1; st <= strategies.Length(); st++) {
+      if (strategies[st]->m_offset >= 0) {
+	oldOffsets[pl][k] = strategies[st]->m_offset;
+	newOffsets[pl][k++] = (strategies[st]->m_number - 1) * size;
+      }
+    }
+    size *= strategies.Length();
   }
 
   Array<GameOutcomeRep *> newResults(size);
   for (int i = 1; i <= newResults.Length(); newResults[i++] = 0);
 
-  for (StrategyProfileIterator iter(StrategySupportProfile(const_cast<GameTableRep *>(this)));
-       !iter.AtEnd(); iter++) {
-    long newindex = 1L;
-    for (int pl = 1; pl <= m_players.Length(); pl++) {
-      if (iter.m_profile->GetStrategy(pl)->m_offset < 0) {
-	// This is a contingency involving a new strategy... skip
-	newindex = -1L;
-	break;
-      }
-      else {
-	newindex += (iter.m_profile->GetStrategy(pl)->m_number - 1) * offsets[pl];
-      }
-    }
-
-    if (newindex >= 1) {
-      newResults[newindex] = m_results[iter.m_profile->GetIndex()];
-    }
+  for (ContingencyIterator oldIter(oldOffsets), newIter(newOffsets);
+       !oldIter.AtEnd(); oldIter++, newIter++) {
+    newResults[newIter.GetIndex()] = m_results[oldIter.GetIndex()];
   }
 
   m_results = newResults;
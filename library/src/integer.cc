@@ -176,6 +176,63 @@ static inline void nonnil(const IntegerRep* rep)
   }
 }
 
+//
+// Storage for reps is recycled through per-thread free lists, one for each
+// of the smaller power-of-two allocation sizes.  Exact arithmetic creates
+// and destroys very large numbers of short-lived Integers, almost all of
+// which fit in the first few size classes, so this removes most calls to
+// the system allocator.  Outside of an IntegerArena, each list holds at
+// most I_POOL_DEPTH blocks; inside one, lists grow without bound and are
+// released when the outermost arena on the thread ends.
+//
+
+#if defined(__GNUC__)
+#define I_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define I_THREAD_LOCAL __declspec(thread)
+#else
+#define I_THREAD_LOCAL
+#endif  // __GNUC__
+
+#define I_POOL_CLASSES  6     // blocks of 16, 32, ..., 512 bytes
+#define I_POOL_DEPTH    256
+
+struct IntegerPoolBlock { IntegerPoolBlock *next; };
+
+static I_THREAD_LOCAL IntegerPoolBlock *pool_head[I_POOL_CLASSES];
+static I_THREAD_LOCAL int pool_count[I_POOL_CLASSES];
+static I_THREAD_LOCAL int pool_arenas;
+
+// size class of a power-of-two allocation size, or -1 if not pooled
+static inline int Ipool_class(unsigned int allocsiz)
+{
+  int c = 0;
+  for (unsigned int siz = MIN_INTREP_SIZE; siz < allocsiz; siz <<= 1, c++);
+  return (c < I_POOL_CLASSES) ? c : -1;
+}
+
+static void Ipool_release(void)
+{
+  for (int c = 0; c < I_POOL_CLASSES; c++) {
+    while (pool_head[c] != 0) {
+      IntegerPoolBlock *block = pool_head[c];
+      pool_head[c] = block->next;
+      delete [] (char *) block;
+    }
+    pool_count[c] = 0;
+  }
+}
+
+IntegerArena::IntegerArena(void)
+{
+  pool_arenas++;
+}
+
+IntegerArena::~IntegerArena()
+{
+  if (--pool_arenas == 0) Ipool_release();
+}
+
 // allocate a new Irep. Pad to something close to a power of two.
 
 static IntegerRep* Inew(int newlen)
@@ -184,14 +241,40 @@ static IntegerRep* Inew(int newlen)
     MALLOC_MIN_OVERHEAD;
   unsigned int allocsiz = MIN_INTREP_SIZE;
   while (allocsiz < siz) allocsiz <<= 1;  // find a power of 2
+  int c = Ipool_class(allocsiz);
   allocsiz -= MALLOC_MIN_OVERHEAD;
   //assert((unsigned long) allocsiz < MAX_INTREP_SIZE * sizeof(short));
-    
-  IntegerRep* rep = (IntegerRep *) new char[allocsiz];
+
+  IntegerRep* rep;
+  if (c >= 0 && pool_head[c] != 0) {
+    rep = (IntegerRep *) pool_head[c];
+    pool_head[c] = pool_head[c]->next;
+    pool_count[c]--;
+  }
+  else {
+    rep = (IntegerRep *) new char[allocsiz];
+  }
   rep->sz = (allocsiz - sizeof(IntegerRep) + sizeof(short)) / sizeof(short);
   return rep;
 }
 
+// release a (non-static) Irep allocated by Inew
+
+static void Idelete(IntegerRep* rep)
+{
+  int c = Ipool_class(rep->sz * sizeof(short) + sizeof(IntegerRep) -
+		      sizeof(short) + MALLOC_MIN_OVERHEAD);
+  if (c >= 0 && (pool_arenas > 0 || pool_count[c] < I_POOL_DEPTH)) {
+    IntegerPoolBlock *block = (IntegerPoolBlock *) rep;
+    block->next = pool_head[c];
+    pool_head[c] = block;
+    pool_count[c]++;
+  }
+  else {
+    delete [] (char *) rep;
+  }
+}
+
 // allocate: use the bits in src if non-null, clear the rest
 
 IntegerRep* Ialloc(IntegerRep* old, const unsigned short* src, int srclen, int newsgn,
@@ -209,7 +292,7 @@ IntegerRep* Ialloc(IntegerRep* old, const unsigned short* src, int srclen, int n
   scpy(src, rep->s, srclen);
   Iclear_from(rep, srclen);
 
-  if (old != rep && old != 0 && !STATIC_IntegerRep(old)) delete old;
+  if (old != rep && old != 0 && !STATIC_IntegerRep(old)) Idelete(old);
   return rep;
 }
 
@@ -220,7 +303,7 @@ IntegerRep* Icalloc(IntegerRep* old, int newlen)
   IntegerRep* rep;
   if (old == 0 || newlen > old->sz)
   {
-    if (old != 0 && !STATIC_IntegerRep(old)) delete old;
+    if (old != 0 && !STATIC_IntegerRep(old)) Idelete(old);
     rep = Inew(newlen);
   }
   else
@@ -253,7 +336,7 @@ IntegerRep* Iresize(IntegerRep* old, int newlen)
       rep = Inew(newlen);
       scpy(old->s, rep->s, oldlen);
       rep->sgn = old->sgn;
-      if (!STATIC_IntegerRep(old)) delete old;
+      if (!STATIC_IntegerRep(old)) Idelete(old);
     }
     else
       rep = old;
@@ -289,7 +372,7 @@ IntegerRep* Icopy(IntegerRep* old, const IntegerRep* src)
     int newlen = src->len;
     if (old == 0 || newlen > old->sz)
     {
-      if (old != 0 && !STATIC_IntegerRep(old)) delete old;
+      if (old != 0 && !STATIC_IntegerRep(old)) Idelete(old);
       rep = Inew(newlen);
     }
     else
@@ -328,7 +411,7 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
   IntegerRep* rep;
   if (old == 0 || srclen > old->sz)
   {
-    if (old != 0 && !STATIC_IntegerRep(old)) delete old;
+    if (old != 0 && !STATIC_IntegerRep(old)) Idelete(old);
     rep = Inew(srclen);
   }
   else
@@ -361,7 +444,7 @@ IntegerRep* Icopy_one(IntegerRep* old, int newsgn)
 {
   if (old == 0 || 1 > old->sz)
   {
-    if (old != 0 && !STATIC_IntegerRep(old)) delete old;
+    if (old != 0 && !STATIC_IntegerRep(old)) Idelete(old);
     return newsgn==I_NEGATIVE ? &_MinusOneRep : &_OneRep;
   }
 
@@ -372,6 +455,83 @@ IntegerRep* Icopy_one(IntegerRep* old, int newsgn)
   return old;
 }
 
+// allocate & copy space for a 64-bit magnitude; unlike Icopy_ulong,
+// this does not depend on the width of long on the platform
+
+static IntegerRep* Icopy_uint64(IntegerRep* old, uint64_t x)
+{
+  unsigned short src[4];
+  unsigned short srclen = 0;
+  while (x != 0)
+  {
+    src[srclen++] = (unsigned short) (x & I_MAXNUM);
+    x >>= I_SHIFT;
+  }
+
+  // Static reps are never written to, even when the result is zero
+  IntegerRep* rep;
+  if (old == 0 || STATIC_IntegerRep(old) || srclen > old->sz)
+  {
+    if (old != 0 && !STATIC_IntegerRep(old)) Idelete(old);
+    rep = Inew(srclen);
+  }
+  else
+    rep = old;
+
+  rep->len = srclen;
+  rep->sgn = I_POSITIVE;
+
+  scpy(src, rep->s, srclen);
+
+  return rep;
+}
+
+IntegerRep* Icopy_int64(IntegerRep* old, int64_t x)
+{
+  int newsgn = (x >= 0);
+  IntegerRep* rep = Icopy_uint64(old, newsgn ? (uint64_t) x : -(uint64_t) x);
+  rep->sgn = newsgn;
+  return rep;
+}
+
+// magnitude of a rep with at most four digits
+
+static inline uint64_t Imag_uint64(const IntegerRep* rep)
+{
+  uint64_t a = 0;
+  for (int i = rep->len - 1; i >= 0; --i)
+    a = (a << I_SHIFT) | rep->s[i];
+  return a;
+}
+
+// Stein's binary gcd on machine words
+
+uint64_t Igcd64(uint64_t u, uint64_t v)
+{
+  if (u == 0) return v;
+  if (v == 0) return u;
+
+#if defined(__GNUC__)
+  int k = __builtin_ctzll(u | v);
+  u >>= __builtin_ctzll(u);
+  do {
+    v >>= __builtin_ctzll(v);
+    if (u > v) { uint64_t t = v; v = u; u = t; }
+    v -= u;
+  } while (v != 0);
+#else
+  int k = 0;
+  while (((u | v) & 1) == 0) { u >>= 1; v >>= 1; ++k; }
+  while ((u & 1) == 0) u >>= 1;
+  do {
+    while ((v & 1) == 0) v >>= 1;
+    if (u > v) { uint64_t t = v; v = u; u = t; }
+    v -= u;
+  } while (v != 0);
+#endif  // __GNUC__
+  return u << k;
+}
+
 // convert to a legal two's complement long if possible
 // if too big, return most negative/positive value
 
@@ -1269,8 +1429,8 @@ IntegerRep* div(const IntegerRep* x, const IntegerRep* y, IntegerRep* q)
     q = Icalloc(q, ql);
     do_divide(r->s, yy->s, yl, q->s, ql);
 
-    if (yy != y && !STATIC_IntegerRep(yy)) delete yy;
-    if (!STATIC_IntegerRep(r)) delete r;
+    if (yy != y && !STATIC_IntegerRep(yy)) Idelete(yy);
+    if (!STATIC_IntegerRep(r)) Idelete(r);
   }
   q->sgn = samesign;
   Icheck(q);
@@ -1339,7 +1499,7 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
     q = Icalloc(q, ql);
     do_divide(r->s, ys, yl, q->s, ql);
 
-    if (!STATIC_IntegerRep(r)) delete r;
+    if (!STATIC_IntegerRep(r)) Idelete(r);
   }
   q->sgn = samesign;
   Icheck(q);
@@ -1422,7 +1582,7 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
     }
     Icheck(r);
     rem = Itolong(r);
-    if (!STATIC_IntegerRep(r)) delete r;
+    if (!STATIC_IntegerRep(r)) Idelete(r);
   }
   rem = abs(Integer(rem)).as_long();
   if (xsgn == I_NEGATIVE) rem = -rem;
@@ -1491,7 +1651,7 @@ void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
     q = Icalloc(q, ql);
     do_divide(r->s, yy->s, yl, q->s, ql);
 
-    if (yy != y && !STATIC_IntegerRep(yy)) delete yy;
+    if (yy != y && !STATIC_IntegerRep(yy)) Idelete(yy);
     if (prescale != 1)
     {
       Icheck(r);
@@ -1548,7 +1708,7 @@ IntegerRep* mod(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
       
     do_divide(r->s, yy->s, yl, 0, xl - yl + 1);
 
-    if (yy != y && !STATIC_IntegerRep(yy)) delete yy;
+    if (yy != y && !STATIC_IntegerRep(yy)) Idelete(yy);
 
     if (prescale != 1)
     {
@@ -1907,6 +2067,9 @@ IntegerRep* gcd(const IntegerRep* x, const IntegerRep* y)
     return Ialloc(0, x->s, ul, I_POSITIVE, ul);
   else if (ul == 0)
     return Ialloc(0, y->s, vl, I_POSITIVE, vl);
+  else if (ul <= 4 && vl <= 4)
+    // both operands fit in a machine word
+    return Icopy_uint64(0, Igcd64(Imag_uint64(x), Imag_uint64(y)));
 
   IntegerRep* u = Ialloc(0, x->s, ul, I_POSITIVE, ul);
   IntegerRep* v = Ialloc(0, y->s, vl, I_POSITIVE, vl);
@@ -1984,8 +2147,8 @@ IntegerRep* gcd(const IntegerRep* x, const IntegerRep* y)
       t = add(t, 0, u, 0, t);
     }
   }
-  if (!STATIC_IntegerRep(t)) delete t;
-  if (!STATIC_IntegerRep(v)) delete v;
+  if (!STATIC_IntegerRep(t)) Idelete(t);
+  if (!STATIC_IntegerRep(v)) Idelete(v);
   if (k != 0) u = lshift(u, k, u);
   return u;
 }
@@ -2043,7 +2206,7 @@ IntegerRep* power(const IntegerRep* x, long y, IntegerRep* r)
       else
         b = multiply(b, b, b);
     }
-    if (!STATIC_IntegerRep(b)) delete b;
+    if (!STATIC_IntegerRep(b)) Idelete(b);
   }
   r->sgn = sgn;
   Icheck(r);
@@ -2194,9 +2357,110 @@ std::string Itoa(const IntegerRep *x, int base, int width)
   return cvtItoa(x, fmtbase, fmtlen, base, 0, width, 0, ' ', 'X', 0);
 }
 
+//
+// Conversion to decimal text in a caller-supplied buffer.  Magnitudes
+// which fit in a machine word are converted directly, and moderate ones
+// by repeated division by 10^4.  Longer ones are split by dividing by a
+// power of ten of about half their length, and the two halves converted
+// recursively, so the work is dominated by a few large divisions rather
+// than a quadratic number of short ones.
+//
+
+#define I_DC_THRESHOLD  32      // length above which to split
+
+// Writes the digits of the magnitude of x, left-padded with zeros to
+// at least p_width digits; returns a pointer past the last digit written.
+static char* Iwrite_magnitude(const IntegerRep* x, char* p_buf, long p_width)
+{
+  if (x->len > I_DC_THRESHOLD)
+  {
+    long k = (long) (x->len * I_SHIFT * 0.30103) / 2;
+    IntegerRep* ten = Icopy_long(0, 10);
+    IntegerRep* p = power(ten, k, 0);
+    IntegerRep* a = abs(x, 0);
+    IntegerRep* q = div(a, p, 0);
+    IntegerRep* r = mod(a, p, 0);
+    p_buf = Iwrite_magnitude(q, p_buf, (p_width > k) ? p_width - k : 0);
+    p_buf = Iwrite_magnitude(r, p_buf, k);
+    if (!STATIC_IntegerRep(ten)) Idelete(ten);
+    if (!STATIC_IntegerRep(p)) Idelete(p);
+    if (!STATIC_IntegerRep(a)) Idelete(a);
+    if (!STATIC_IntegerRep(q)) Idelete(q);
+    if (!STATIC_IntegerRep(r)) Idelete(r);
+    return p_buf;
+  }
+
+  char digits[I_DC_THRESHOLD * 5];     // five decimal digits per I_SHIFT bits
+  char* e = digits + sizeof(digits);
+  char* s = e;
+  if (x->len <= 4)
+  {
+    uint64_t a = Imag_uint64(x);
+    while (a != 0)
+    {
+      *--s = (char) ('0' + a % 10);
+      a /= 10;
+    }
+  }
+  else
+  {
+    IntegerRep* z = Icopy(0, x);
+    while (z->len != 0)
+    {
+      int rem = unscale(z->s, z->len, 10000, z->s);
+      Icheck(z);
+      for (int i = 0; i < 4 && (rem != 0 || z->len != 0); ++i)
+      {
+        *--s = (char) ('0' + rem % 10);
+        rem /= 10;
+      }
+    }
+    if (!STATIC_IntegerRep(z)) Idelete(z);
+  }
+
+  for (long n = (long) (e - s); n < p_width; ++n)
+    *p_buf++ = '0';
+  memcpy(p_buf, s, e - s);
+  return p_buf + (e - s);
+}
+
+int Integer::text_size() const
+{
+  return rep->len * 5 + 2;
+}
+
+char *Integer::write_text(char *p_buffer) const
+{
+  if (rep->len == 0 || (rep->len == 1 && rep->s[0] == 0))
+    *p_buffer++ = '0';
+  else
+  {
+    if (rep->sgn == I_NEGATIVE) *p_buffer++ = '-';
+    p_buffer = Iwrite_magnitude(rep, p_buffer, 0);
+  }
+  *p_buffer = '\0';
+  return p_buffer;
+}
+
 std::ostream &operator<<(std::ostream &s, const Integer &y)
 {
-  return s << Itoa(y.rep);
+  char text[64];
+  if (y.text_size() <= (int) sizeof(text))
+  {
+    char *end = y.write_text(text);
+    return s.write(text, end - text);
+  }
+  std::string buffer(y.text_size(), '\0');
+  char *end = y.write_text(&buffer[0]);
+  return s.write(buffer.data(), end - &buffer[0]);
+}
+
+template<>
+std::string lexical_cast(const Integer &p_value)
+{
+  std::string buffer(p_value.text_size(), '\0');
+  buffer.resize(p_value.write_text(&buffer[0]) - &buffer[0]);
+  return buffer;
 }
 
 std::string cvtItoa(const IntegerRep *x, std::string fmt, int& fmtlen, int base, int showbase,
@@ -2242,7 +2506,7 @@ std::string cvtItoa(const IntegerRep *x, std::string fmt, int& fmtlen, int base,
             ch += '0';
           *--s = ch;
         }
-	if (!STATIC_IntegerRep(z)) delete z;
+	if (!STATIC_IntegerRep(z)) Idelete(z);
         break;
       }
       else
@@ -2373,7 +2637,7 @@ Integer::Integer(unsigned long y) :rep(Icopy_ulong(0, y)) {}
 
 Integer::Integer(const Integer&  y) :rep(Icopy(0, y.rep)) {}
 
-Integer::~Integer() { if (rep && !STATIC_IntegerRep(rep)) delete[] rep; }
+Integer::~Integer() { if (rep && !STATIC_IntegerRep(rep)) Idelete(rep); }
 
 Integer &Integer::operator=(const Integer &y)
 {
@@ -21,6 +21,7 @@
 //
 
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/nash/ipa.h"
 #include "gambit/gtracer/gtracer.h"
 
@@ -65,13 +66,30 @@ NashIPAStrategySolver::Solve(const Game &p_game,
     A = new nfgame(p_game->NumPlayers(), actions, payoffs);
   
     int *profile = new int[p_game->NumPlayers()];
-    for (StrategyProfileIterator iter(p_game); !iter.AtEnd(); iter++) {
-      for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-	profile[pl-1] = (*iter)->GetStrategy(pl)->GetNumber() - 1;
+    const GameTableRep *table =
+      dynamic_cast<const GameTableRep *>(static_cast<GameRep *>(p_game));
+    if (table) {
+      ContingencyIterator::Offsets offsets =
+	ContingencyIterator::TableOffsets(p_game->NumStrategies());
+      for (ContingencyIterator iter(offsets); !iter.AtEnd(); iter++) {
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  profile[pl-1] = iter.GetStrategy(pl) - 1;
+	}
+
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  A->setPurePayoff(pl-1, profile, table->GetPayoff<double>(iter.GetIndex(), pl));
+	}
       }
+    }
+    else {
+      for (StrategyProfileIterator iter(p_game); !iter.AtEnd(); iter++) {
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  profile[pl-1] = (*iter)->GetStrategy(pl)->GetNumber() - 1;
+	}
 
-      for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-	A->setPurePayoff(pl-1, profile, (*iter)->GetPayoff(pl));
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  A->setPurePayoff(pl-1, profile, (*iter)->GetPayoff(pl));
+	}
       }
     }
   }
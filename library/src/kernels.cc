@@ -0,0 +1,259 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/kernels.cc
+// Vectorized kernels for dense floating-point linear algebra
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include "gambit/kernels.h"
+
+//
+// SSE2 is part of the x86-64 baseline, so it is used whenever the
+// compiler targets it.  AVX2 versions are compiled with per-function
+// target attributes (GCC 4.9 and later) and selected at runtime.
+//
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GAMBIT_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(GAMBIT_KERNELS_SSE2) && defined(__GNUC__) && !defined(__clang__) && \
+  (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define GAMBIT_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+namespace Gambit {
+
+namespace kernels {
+
+namespace {
+
+//
+// The inner product is accumulated in eight partial sums, with element i
+// going to sum i % 8; the sums are combined as
+//   ((s0+s4) + (s1+s5)) + ((s2+s6) + (s3+s7))
+// and any remaining elements are then added in order.  Each implementation
+// follows this scheme exactly.
+//
+
+#ifndef GAMBIT_KERNELS_SSE2
+
+double DotScalar(const double *x, const double *y, int n)
+{
+  double s[8] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    for (int j = 0; j < 8; j++) {
+      s[j] += x[i+j] * y[i+j];
+    }
+  }
+  double sum = ((s[0] + s[4]) + (s[1] + s[5])) + ((s[2] + s[6]) + (s[3] + s[7]));
+  for (; i < n; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+void AxpyScalar(double a, const double *x, double *y, int n)
+{
+  for (int i = 0; i < n; i++) {
+    y[i] += a * x[i];
+  }
+}
+
+#endif  // !GAMBIT_KERNELS_SSE2
+
+void RotateScalar(double c, double s, double *x, double *y, int n)
+{
+  for (int i = 0; i < n; i++) {
+    double xi = x[i], yi = y[i];
+    x[i] = c * xi + s * yi;
+    y[i] = -s * xi + c * yi;
+  }
+}
+
+#ifdef GAMBIT_KERNELS_SSE2
+
+double DotSSE2(const double *x, const double *y, int n)
+{
+  __m128d s01 = _mm_setzero_pd(), s23 = _mm_setzero_pd();
+  __m128d s45 = _mm_setzero_pd(), s67 = _mm_setzero_pd();
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    s01 = _mm_add_pd(s01, _mm_mul_pd(_mm_loadu_pd(x+i), _mm_loadu_pd(y+i)));
+    s23 = _mm_add_pd(s23, _mm_mul_pd(_mm_loadu_pd(x+i+2), _mm_loadu_pd(y+i+2)));
+    s45 = _mm_add_pd(s45, _mm_mul_pd(_mm_loadu_pd(x+i+4), _mm_loadu_pd(y+i+4)));
+    s67 = _mm_add_pd(s67, _mm_mul_pd(_mm_loadu_pd(x+i+6), _mm_loadu_pd(y+i+6)));
+  }
+  double lo[2], hi[2];
+  _mm_storeu_pd(lo, _mm_add_pd(s01, s45));
+  _mm_storeu_pd(hi, _mm_add_pd(s23, s67));
+  double sum = (lo[0] + lo[1]) + (hi[0] + hi[1]);
+  for (; i < n; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+void AxpySSE2(double a, const double *x, double *y, int n)
+{
+  __m128d av = _mm_set1_pd(a);
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(y+i, _mm_add_pd(_mm_loadu_pd(y+i),
+				  _mm_mul_pd(av, _mm_loadu_pd(x+i))));
+  }
+  for (; i < n; i++) {
+    y[i] += a * x[i];
+  }
+}
+
+void RotateSSE2(double c, double s, double *x, double *y, int n)
+{
+  __m128d cv = _mm_set1_pd(c), sv = _mm_set1_pd(s), nsv = _mm_set1_pd(-s);
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d xv = _mm_loadu_pd(x+i), yv = _mm_loadu_pd(y+i);
+    _mm_storeu_pd(x+i, _mm_add_pd(_mm_mul_pd(cv, xv), _mm_mul_pd(sv, yv)));
+    _mm_storeu_pd(y+i, _mm_add_pd(_mm_mul_pd(nsv, xv), _mm_mul_pd(cv, yv)));
+  }
+  RotateScalar(c, s, x+i, y+i, n-i);
+}
+
+#endif  // GAMBIT_KERNELS_SSE2
+
+#ifdef GAMBIT_KERNELS_AVX2
+
+// Separate multiplies and adds are used rather than fused multiply-add,
+// so that results agree with the other implementations.
+
+__attribute__((target("avx2")))
+double DotAVX2(const double *x, const double *y, int n)
+{
+  __m256d s0 = _mm256_setzero_pd(), s4 = _mm256_setzero_pd();
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    s0 = _mm256_add_pd(s0, _mm256_mul_pd(_mm256_loadu_pd(x+i),
+					 _mm256_loadu_pd(y+i)));
+    s4 = _mm256_add_pd(s4, _mm256_mul_pd(_mm256_loadu_pd(x+i+4),
+					 _mm256_loadu_pd(y+i+4)));
+  }
+  double s[4];
+  _mm256_storeu_pd(s, _mm256_add_pd(s0, s4));
+  double sum = (s[0] + s[1]) + (s[2] + s[3]);
+  for (; i < n; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+__attribute__((target("avx2")))
+void AxpyAVX2(double a, const double *x, double *y, int n)
+{
+  __m256d av = _mm256_set1_pd(a);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(y+i, _mm256_add_pd(_mm256_loadu_pd(y+i),
+					_mm256_mul_pd(av, _mm256_loadu_pd(x+i))));
+  }
+  for (; i < n; i++) {
+    y[i] += a * x[i];
+  }
+}
+
+__attribute__((target("avx2")))
+void RotateAVX2(double c, double s, double *x, double *y, int n)
+{
+  __m256d cv = _mm256_set1_pd(c), sv = _mm256_set1_pd(s);
+  __m256d nsv = _mm256_set1_pd(-s);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d xv = _mm256_loadu_pd(x+i), yv = _mm256_loadu_pd(y+i);
+    _mm256_storeu_pd(x+i, _mm256_add_pd(_mm256_mul_pd(cv, xv),
+					_mm256_mul_pd(sv, yv)));
+    _mm256_storeu_pd(y+i, _mm256_add_pd(_mm256_mul_pd(nsv, xv),
+					_mm256_mul_pd(cv, yv)));
+  }
+  RotateScalar(c, s, x+i, y+i, n-i);
+}
+
+#endif  // GAMBIT_KERNELS_AVX2
+
+//
+// Dispatch.  The pointers start out at resolver functions, which pick
+// the implementation on first use.  Concurrent first calls may each
+// resolve, but they store the same values.
+//
+
+double DotResolve(const double *, const double *, int);
+void AxpyResolve(double, const double *, double *, int);
+void RotateResolve(double, double, double *, double *, int);
+
+double (*s_dot)(const double *, const double *, int) = DotResolve;
+void (*s_axpy)(double, const double *, double *, int) = AxpyResolve;
+void (*s_rotate)(double, double, double *, double *, int) = RotateResolve;
+const char *s_name = "scalar";
+
+void Resolve(void)
+{
+#if defined(GAMBIT_KERNELS_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    s_dot = DotAVX2;  s_axpy = AxpyAVX2;  s_rotate = RotateAVX2;
+    s_name = "avx2";
+    return;
+  }
+#endif
+#if defined(GAMBIT_KERNELS_SSE2)
+  s_dot = DotSSE2;  s_axpy = AxpySSE2;  s_rotate = RotateSSE2;
+  s_name = "sse2";
+#else
+  s_dot = DotScalar;  s_axpy = AxpyScalar;  s_rotate = RotateScalar;
+#endif
+}
+
+double DotResolve(const double *x, const double *y, int n)
+{ Resolve();  return s_dot(x, y, n); }
+
+void AxpyResolve(double a, const double *x, double *y, int n)
+{ Resolve();  s_axpy(a, x, y, n); }
+
+void RotateResolve(double c, double s, double *x, double *y, int n)
+{ Resolve();  s_rotate(c, s, x, y, n); }
+
+}  // end anonymous namespace
+
+double Dot(const double *x, const double *y, int n)
+{ return s_dot(x, y, n); }
+
+void Axpy(double a, const double *x, double *y, int n)
+{ s_axpy(a, x, y, n); }
+
+void Rotate(double c, double s, double *x, double *y, int n)
+{ s_rotate(c, s, x, y, n); }
+
+const char *Implementation(void)
+{
+  if (s_dot == DotResolve)  Resolve();
+  return s_name;
+}
+
+}  // end namespace Gambit::kernels
+
+}  // end namespace Gambit
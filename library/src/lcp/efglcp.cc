@@ -24,30 +24,84 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <map>
 #include "gambit/gambit.h"
 #include "gambit/linalg/lemketab.h"
 #include "gambit/linalg/lhtab.h"
+#include "gambit/linalg/sparselemke.h"
 #include "gambit/nash/lcp.h"
 
 namespace Gambit {
 namespace Nash {
 
+namespace {
+
+//
+// A LemkeTableau over a dense matrix, through which the covering vector
+// (column 0 of the matrix) can be changed, as for SparseLemkeTableau.
+//
+template <class T> class DenseSequenceTableau : public linalg::LemkeTableau<T> {
+public:
+  DenseSequenceTableau(Matrix<T> &A, const Vector<T> &b)
+    : linalg::LemkeTableau<T>(A, b), m_A(&A) { }
+
+  void SetCovering(int row, const T &value) { (*m_A)(row, 0) = value; }
+
+private:
+  Matrix<T> *m_A;
+};
+
+}  // end anonymous namespace
+
 template <class T> class NashLcpBehaviorSolver<T>::Solution {
 public:
   int ns1, ns2, ni1, ni2;
   Rational maxpay;
   T eps;
   List<GameInfoset> isets1, isets2;
-  List<Gambit::linalg::BFS<T> > m_list;
+  Gambit::linalg::BasisSet m_visited;
   List<MixedBehaviorProfile<T> > m_equilibria;
 
-  bool AddBFS(const linalg::LemkeTableau<T> &);
+  /// Nonzero entries of the LCP matrix, other than the covering vector
+  std::map<std::pair<int, int>, T> m_entries;
+  /// For each player, the position of each of their infosets in
+  /// isets1 or isets2, or zero if it is not reachable
+  Array<int> m_infosetIndex[2];
+  /// For each player, the index of the sequence preceding the first
+  /// action at the infoset in each position, so that sequence offsets
+  /// need not be recomputed at every node
+  Array<int> m_sequenceOffset[2];
+
+  void IndexSequences(const BehaviorSupportProfile &);
+  T &Entry(int row, int col) { return m_entries[std::make_pair(row, col)]; }
+
+  template <class Tab> bool AddBFS(const Tab &);
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
 };
 
-template <class T> bool 
-NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::LemkeTableau<T> &tableau)
+template <class T> void
+NashLcpBehaviorSolver<T>::Solution::IndexSequences(const BehaviorSupportProfile &p_support)
+{
+  for (int pl = 1; pl <= 2; pl++) {
+    const List<GameInfoset> &isets = (pl == 1) ? isets1 : isets2;
+    GamePlayer player = p_support.GetGame()->GetPlayer(pl);
+    m_infosetIndex[pl-1] = Array<int>(player->NumInfosets());
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      m_infosetIndex[pl-1][iset] = 0;
+    }
+    m_sequenceOffset[pl-1] = Array<int>(isets.size());
+    int snew = 1;
+    for (int i = 1; i <= isets.size(); i++) {
+      m_infosetIndex[pl-1][isets[i]->GetNumber()] = i;
+      m_sequenceOffset[pl-1][i] = snew;
+      snew += p_support.NumActions(pl, isets[i]->GetNumber());
+    }
+  }
+}
+
+template <class T> template <class Tab> bool 
+NashLcpBehaviorSolver<T>::Solution::AddBFS(const Tab &tableau)
 {
   Gambit::linalg::BFS<T> cbfs;
   Vector<T> v(tableau.MinRow(), tableau.MaxRow());
@@ -59,13 +113,7 @@ NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::LemkeTableau<T> &tablea
     }
   }
 
-  if (!m_list.Contains(cbfs)) {
-    m_list.push_back(cbfs);
-    return true;
-  }
-  else {
-    return false;
-  }
+  return m_visited.Insert(cbfs);
 }
 
 //
@@ -84,54 +132,97 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
 
-  Gambit::linalg::BFS<T> cbfs;
-  int i, j;
   Solution solution;
 
   solution.isets1 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(1));
   solution.isets2 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(2));
 
-  int ntot;
   solution.ns1 = p_support.NumSequences(1);
   solution.ns2 = p_support.NumSequences(2);
   solution.ni1 = p_support.GetGame()->GetPlayer(1)->NumInfosets()+1;
   solution.ni2 = p_support.GetGame()->GetPlayer(2)->NumInfosets()+1;
+  solution.IndexSequences(p_support);
+
+  solution.maxpay = p_support.GetGame()->GetMaxPayoff() + Rational(1);
 
-  ntot = solution.ns1+solution.ns2+solution.ni1+solution.ni2;
+  FillTableau(p_support, p_support.GetGame()->GetRoot(), (T) 1, 1, 1,
+	      solution);
+  solution.Entry(1,solution.ns1+solution.ns2+1) = (T) 1;
+  solution.Entry(solution.ns1+solution.ns2+1,1) = -(T) 1;
+  solution.Entry(solution.ns1+1,solution.ns1+solution.ns2+solution.ni1+1) = (T) 1;
+  solution.Entry(solution.ns1+solution.ns2+solution.ni1+1,solution.ns1+1) = -(T) 1;
 
+  SolveLcp(p_support, solution);
+  return solution.m_equilibria;
+}
+
+//
+// SolveLcp sets up the tableau from the entries collected by FillTableau.
+// In exact arithmetic the matrix is held densely; in floating point it is
+// held by columns, so that games with many sequences can be solved.
+//
+template <class T> void
+NashLcpBehaviorSolver<T>::SolveLcp(const BehaviorSupportProfile &p_support,
+				   Solution &p_solution) const
+{
+  int ntot = p_solution.ns1+p_solution.ns2+p_solution.ni1+p_solution.ni2;
   Matrix<T> A(1,ntot,0,ntot);
   Vector<T> b(1,ntot);
 
-  solution.maxpay = p_support.GetGame()->GetMaxPayoff() + Rational(1);
-
-  T prob = (T)1;
-  for (i = A.MinRow(); i <= A.MaxRow(); i++) {
+  for (int i = A.MinRow(); i <= A.MaxRow(); i++) {
     b[i] = (T) 0;
-    for (j = A.MinCol(); j <= A.MaxCol(); j++) {
+    for (int j = A.MinCol(); j <= A.MaxCol(); j++) {
       A(i,j) = (T) 0; 
     }
+    A(i,0) = -(T) 1;
   }
+  for (typename std::map<std::pair<int, int>, T>::const_iterator entry = p_solution.m_entries.begin();
+       entry != p_solution.m_entries.end(); ++entry) {
+    A(entry->first.first, entry->first.second) = entry->second;
+  }
+  b[p_solution.ns1+p_solution.ns2+1] = -(T)1;
+  b[p_solution.ns1+p_solution.ns2+p_solution.ni1+1] = -(T)1;
 
-  FillTableau(p_support, A, p_support.GetGame()->GetRoot(), prob, 1, 1, 0, 0,
-	      solution);
-  for (i = A.MinRow(); i <= A.MaxRow(); i++) { 
-    A(i,0) = -(T) 1;
+  DenseSequenceTableau<T> tab(A, b);
+  SolveTableau(p_support, tab, p_solution);
+}
+
+template <> void
+NashLcpBehaviorSolver<double>::SolveLcp(const BehaviorSupportProfile &p_support,
+					Solution &p_solution) const
+{
+  int ntot = p_solution.ns1+p_solution.ns2+p_solution.ni1+p_solution.ni2;
+  std::vector<linalg::SparseColumn> columns(ntot + 1);
+  Vector<double> covering(1,ntot), b(1,ntot);
+
+  covering = -1.0;
+  b = 0.0;
+  for (std::map<std::pair<int, int>, double>::const_iterator entry = p_solution.m_entries.begin();
+       entry != p_solution.m_entries.end(); ++entry) {
+    if (entry->second != 0.0) {
+      columns[entry->first.second].push_back(std::make_pair(entry->first.first,
+							   entry->second));
+    }
   }
-  A(1,solution.ns1+solution.ns2+1) = (T) 1;
-  A(solution.ns1+solution.ns2+1,1) = -(T) 1;
-  A(solution.ns1+1,solution.ns1+solution.ns2+solution.ni1+1) = (T) 1;
-  A(solution.ns1+solution.ns2+solution.ni1+1,solution.ns1+1) = -(T) 1;
-  b[solution.ns1+solution.ns2+1] = -(T)1;
-  b[solution.ns1+solution.ns2+solution.ni1+1] = -(T)1;
-
-  linalg::LemkeTableau<T> tab(A,b);
+  p_solution.m_entries.clear();
+  b[p_solution.ns1+p_solution.ns2+1] = -1.0;
+  b[p_solution.ns1+p_solution.ns2+p_solution.ni1+1] = -1.0;
+
+  linalg::SparseLemkeTableau tab(columns, covering, b);
+  SolveTableau(p_support, tab, p_solution);
+}
+
+template <class T> template <class Tab> void
+NashLcpBehaviorSolver<T>::SolveTableau(const BehaviorSupportProfile &p_support,
+				       Tab &tab, Solution &solution) const
+{
   solution.eps = tab.Epsilon();
   
   try {
     if (m_stopAfter != 1) {
       try {
 	AllLemke(p_support, solution.ns1+solution.ns2+1, 
-		 tab, 0, A, solution);
+		 tab, 0, solution);
       }
       catch (EquilibriumLimitReached &) {
 	// Just handle this silently; equilibria are already printed
@@ -158,7 +249,6 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   catch (std::runtime_error &e) {
     std::cerr << "Error: " << e.what() << std::endl;
   }
-  return solution.m_equilibria;
 }
 
 
@@ -169,10 +259,9 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 // From each new accessible equilibrium, it follows
 // all possible paths, adding any new equilibria to the List.  
 //
-template <class T> void
+template <class T> template <class Tab> void
 NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
-				   int j, linalg::LemkeTableau<T> &B, int depth,
-				   Matrix<T> &A,
+				   int j, Tab &B, int depth,
 				   Solution &p_solution) const
 {
   if (m_maxDepth != 0 && depth > m_maxDepth) {
@@ -188,8 +277,8 @@ NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
   for (int i = B.MinRow(); i <= B.MaxRow() && !newsol; i++) {
     if (i == j) continue;
 
-    linalg::LemkeTableau<T> BCopy(B);
-    A(i,0) = -small_num;
+    Tab BCopy(B);
+    BCopy.SetCovering(i, -small_num);
     BCopy.Refactor();
 
     int missing;
@@ -222,71 +311,64 @@ NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
       // gout << ": Dead End";
     }
       
-    A(i,0) = (T) -1;
+    BCopy.SetCovering(i, (T) -1);
     if (newsol) {
       BCopy.Refactor();
-      AllLemke(p_support, i, BCopy, depth+1, A, p_solution);
+      AllLemke(p_support, i, BCopy, depth+1, p_solution);
     }
   }
 }
 
 template <class T>
 void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_support, 
-					Matrix<T> &A,
-					const GameNode &n, T prob,
-					int s1, int s2, int i1, int i2,
-					Solution &p_solution) const
+					   const GameNode &n, T prob,
+					   int s1, int s2,
+					   Solution &p_solution) const
 {
-  int snew;
   int ns1 = p_solution.ns1;
   int ns2 = p_solution.ns2;
   int ni1 = p_solution.ni1;
 
   GameOutcome outcome = n->GetOutcome();
   if (outcome) {
-    A(s1,ns1+s2) = Rational(A(s1,ns1+s2)) +
+    T &a1 = p_solution.Entry(s1,ns1+s2);
+    a1 = Rational(a1) +
       Rational(prob) * (outcome->GetPayoff<Rational>(1) - p_solution.maxpay);
-    A(ns1+s2,s1) = Rational(A(ns1+s2,s1)) +
+    T &a2 = p_solution.Entry(ns1+s2,s1);
+    a2 = Rational(a2) +
       Rational(prob) * (outcome->GetPayoff<Rational>(2) - p_solution.maxpay);
   }
   if (n->GetInfoset()) {
     if (n->GetPlayer()->IsChance()) {
       GameInfoset infoset = n->GetInfoset();
       for (int i = 1; i <= n->NumChildren(); i++) {
-	FillTableau(p_support, A, n->GetChild(i),
+	FillTableau(p_support, n->GetChild(i),
 		    Rational(prob) * infoset->GetActionProb(i, Rational(0)),
-		    s1, s2, i1, i2, p_solution);
+		    s1, s2, p_solution);
       }
     }
     int pl = n->GetPlayer()->GetNumber();
+    int iset = n->GetInfoset()->GetNumber();
     if (pl==1) {
-      i1=p_solution.isets1.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i1; i++) {
-	snew+=p_support.NumActions(p_solution.isets1[i]->GetPlayer()->GetNumber(),
-				   p_solution.isets1[i]->GetNumber());
-      }
-      A(s1,ns1+ns2+i1+1) = -(T)1;
-      A(ns1+ns2+i1+1,s1) = (T)1;
-      for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
-	A(snew+i,ns1+ns2+i1+1) = (T)1;
-	A(ns1+ns2+i1+1,snew+i) = -(T)1;
-	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,snew+i,s2,i1,i2, p_solution);
+      int i1 = p_solution.m_infosetIndex[0][iset];
+      int snew = p_solution.m_sequenceOffset[0][i1];
+      p_solution.Entry(s1,ns1+ns2+i1+1) = -(T)1;
+      p_solution.Entry(ns1+ns2+i1+1,s1) = (T)1;
+      for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
+	p_solution.Entry(snew+i,ns1+ns2+i1+1) = (T)1;
+	p_solution.Entry(ns1+ns2+i1+1,snew+i) = -(T)1;
+	FillTableau(p_support, n->GetChild(p_support.GetAction(pl, iset, i)->GetNumber()),prob,snew+i,s2, p_solution);
       }
     }
     if(pl==2) {
-      i2=p_solution.isets2.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i2; i++) {
-	snew+=p_support.NumActions(p_solution.isets2[i]->GetPlayer()->GetNumber(),
-				   p_solution.isets2[i]->GetNumber());
-      }
-      A(ns1+s2,ns1+ns2+ni1+i2+1) = -(T)1;
-      A(ns1+ns2+ni1+i2+1,ns1+s2) = (T)1;
-      for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
-	A(ns1+snew+i,ns1+ns2+ni1+i2+1) = (T)1;
-	A(ns1+ns2+ni1+i2+1,ns1+snew+i) = -(T)1;
-	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,s1,snew+i,i1,i2, p_solution);
+      int i2 = p_solution.m_infosetIndex[1][iset];
+      int snew = p_solution.m_sequenceOffset[1][i2];
+      p_solution.Entry(ns1+s2,ns1+ns2+ni1+i2+1) = -(T)1;
+      p_solution.Entry(ns1+ns2+ni1+i2+1,ns1+s2) = (T)1;
+      for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
+	p_solution.Entry(ns1+snew+i,ns1+ns2+ni1+i2+1) = (T)1;
+	p_solution.Entry(ns1+ns2+ni1+i2+1,ns1+snew+i) = -(T)1;
+	FillTableau(p_support, n->GetChild(p_support.GetAction(pl, iset, i)->GetNumber()),prob,s1,snew+i, p_solution);
       }
     }
     
@@ -294,9 +376,9 @@ void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_suppo
 }
 
 
-template <class T> void
+template <class T> template <class Tab> void
 NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
-				     const linalg::LemkeTableau<T> &tab, 
+				     const Tab &tab, 
 				     MixedBehaviorProfile<T> &v, 
 				     const Vector<T> &sol,
 				     const GameNode &n, int s1, int s2,
@@ -315,11 +397,8 @@ NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
       }
     }
     else if (pl == 1) {
-      int inf = p_solution.isets1.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(1, p_solution.isets1[i]->GetNumber()); 
-      }
+      int inf = p_solution.m_infosetIndex[0][iset];
+      int snew = p_solution.m_sequenceOffset[0][inf];
       
       for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
@@ -340,11 +419,8 @@ NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
       }
     }
     else if (pl == 2) { 
-      int inf = p_solution.isets2.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(2, p_solution.isets2[i]->GetNumber()); 
-      }
+      int inf = p_solution.m_infosetIndex[1][iset];
+      int snew = p_solution.m_sequenceOffset[1][inf];
 
       for (int i = 1; i<= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
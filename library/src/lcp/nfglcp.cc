@@ -23,8 +23,11 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <algorithm>
+#include <set>
 
 #include "gambit/gambit.h"
+#include "gambit/bimatrix.h"
 #include "gambit/linalg/lhtab.h"
 #include "gambit/nash/lcp.h"
 
@@ -34,65 +37,49 @@ namespace Nash {
 // Anonymous namespace to encapsulate local utility functions
   
 namespace {
-template <class T> Matrix<T> Make_A1(const Game &p_game)
+template <class T> Matrix<T> Make_A1(const BimatrixGame &p_game)
 {
-  int n1 = p_game->Players()[1]->Strategies().size();
-  int n2 = p_game->Players()[2]->Strategies().size();
+  int n1 = p_game.NumRows();
+  int n2 = p_game.NumCols();
   Matrix<T> A1(1, n1, n1+1, n1+n2);
 
-  PureStrategyProfile profile = p_game->NewPureStrategyProfile();
-
-  Rational min = p_game->GetMinPayoff();
+  Rational min = p_game.GetMinPayoff();
   if (min > Rational(0)) {
     min = Rational(0);
   }
   min -= Rational(1);
 
-  Rational max = p_game->GetMaxPayoff();
+  Rational max = p_game.GetMaxPayoff();
   if (max < Rational(0)) {
     max = Rational(0);
   }
 
   Rational fac(1, max - min);
 
-  for (int i = 1; i <= n1; i++)  {
-    profile->SetStrategy(p_game->Players()[1]->Strategies()[i]);
-    for (int j = 1; j <= n2; j++)  {
-      profile->SetStrategy(p_game->Players()[2]->Strategies()[j]);
-      A1(i, n1 + j) = fac * (profile->GetPayoff(1) - min);
-    }
-  }
+  p_game.GetScaledPayoffs(1, min, fac, A1, 0, n1, false);
   return A1;
 }
 
-template <class T> Matrix<T> Make_A2(const Game &p_game)
+template <class T> Matrix<T> Make_A2(const BimatrixGame &p_game)
 {
-  int n1 = p_game->Players()[1]->Strategies().size();
-  int n2 = p_game->Players()[2]->Strategies().size();
+  int n1 = p_game.NumRows();
+  int n2 = p_game.NumCols();
   Matrix<T> A2(n1+1, n1+n2, 1, n1);
 
-  PureStrategyProfile profile = p_game->NewPureStrategyProfile();
-  
-  Rational min = p_game->GetMinPayoff();
+  Rational min = p_game.GetMinPayoff();
   if (min > Rational(0)) {
     min = Rational(0);
   }
   min -= Rational(1);
 
-  Rational max = p_game->GetMaxPayoff();
+  Rational max = p_game.GetMaxPayoff();
   if (max < Rational(0)) {
     max = Rational(0);
   }
 
   Rational fac(1, max - min);
 
-  for (int i = 1; i <= n1; i++)  {
-    profile->SetStrategy(p_game->Players()[1]->Strategies()[i]);
-    for (int j = 1; j <= n2; j++)  {
-      profile->SetStrategy(p_game->Players()[2]->Strategies()[j]);
-      A2(n1 + j, i) = fac * (profile->GetPayoff(2) - min);
-    }
-  }
+  p_game.GetScaledPayoffs(2, min, fac, A2, n1, 0, true);
   return A2;
 }
 
@@ -112,42 +99,16 @@ template <class T> Vector<T> Make_b2(const Game &p_game)
   return b2;
 }
 
-}  // end anonymous namespace
-  
-
-template <class T>
-class NashLcpStrategySolver<T>::Solution {
-public:
-  List<Gambit::linalg::BFS<T> > m_bfsList;
-  List<MixedStrategyProfile<T> > m_equilibria;
-
-  bool Contains(const Gambit::linalg::BFS<T> &p_bfs) const
-  { return m_bfsList.Contains(p_bfs); }
-  void push_back(const Gambit::linalg::BFS<T> &p_bfs)
-  { m_bfsList.push_back(p_bfs); }
-
-  int EquilibriumCount(void) const { return m_equilibria.size(); }
-};
-  
 //
-// Function called when a CBFS is encountered.
-// If it is not already in the list p_list, it is added.
-// The corresponding equilibrium is computed and output.
-// Returns 'true' if the CBFS is new; 'false' if it already appears in the
-// list.
+// Computes the profile corresponding to a CBFS of the Lemke-Howson
+// tableau, normalizing the basic values for each player's strategies.
+// Returns false if the CBFS is the trivial one, in which case there is
+// no corresponding profile.
 //
-template <class T> bool
-NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
-				linalg::LHTableau<T> &p_tableau,
-				Solution &p_solution) const
+template <class T>
+bool BFSToProfile(const Game &p_game, const linalg::BFS<T> &cbfs,
+		  MixedStrategyProfile<T> &profile)
 {
-  Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
-  if (p_solution.Contains(cbfs)) {
-    return false;
-  }
-  p_solution.push_back(cbfs);
-
-  MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0.0)));
   int n1 = p_game->Players()[1]->Strategies().size();
   int n2 = p_game->Players()[2]->Strategies().size();
   T sum = (T) 0;
@@ -184,7 +145,51 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
       profile[strategy] = (T) 0;
     }
   }
+  return true;
+}
+
+}  // end anonymous namespace
   
+
+template <class T>
+class NashLcpStrategySolver<T>::Solution {
+public:
+  Gambit::linalg::BasisSet m_visited;
+  List<MixedStrategyProfile<T> > m_equilibria;
+  // Used by the multithreaded search; guarded by the solution lock
+  int m_stopped;
+  std::string m_error;
+
+  Solution(void) : m_stopped(0) { }
+
+  /// Records p_bfs as visited; returns false if it already was
+  bool Insert(const Gambit::linalg::BFS<T> &p_bfs)
+  { return m_visited.Insert(p_bfs); }
+
+  int EquilibriumCount(void) const { return m_equilibria.size(); }
+};
+  
+//
+// Function called when a CBFS is encountered.
+// If its basis has not been visited before, it is recorded as visited,
+// and the corresponding equilibrium is computed and output.
+// Returns 'true' if the CBFS is new; 'false' if it has been visited.
+//
+template <class T> bool
+NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
+				linalg::LHTableau<T> &p_tableau,
+				Solution &p_solution) const
+{
+  Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
+  if (!p_solution.Insert(cbfs)) {
+    return false;
+  }
+
+  MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0.0)));
+  if (!BFSToProfile(p_game, cbfs, profile)) {
+    return false;
+  }
+
   this->m_onEquilibrium->Render(profile);
   p_solution.m_equilibria.push_back(profile);
 
@@ -197,8 +202,8 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
 
 //
 // AllLemke finds all accessible Nash equilibria by recursively 
-// calling itself.  p_list maintains the list of basic variables 
-// for the equilibria that have already been found.  
+// calling itself.  p_solution records the bases of the CBFSs
+// that have already been visited.
 // From each new accessible equilibrium, it follows
 // all possible paths, adding any new equilibria to the List.  
 //
@@ -227,6 +232,79 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
   }
 }
 
+//
+// ParallelLemke is the multithreaded counterpart of AllLemke.  The search
+// tree is unfolded into tasks, one for each (tableau, label, depth)
+// triple, which idle threads pick up as they become available.  Each task
+// owns its tableau and deletes it when done.  The list of CBFSs found,
+// the equilibria, and the renderer are shared, and are only touched
+// while holding the solution lock, so equilibria are still reported as
+// they are found, although their order may vary from run to run.
+//
+template <class T> void
+NashLcpStrategySolver<T>::ParallelLemke(const Game *p_game, int j,
+					linalg::LHTableau<T> *p_tableau,
+					Solution *p_solution, int depth) const
+{
+  try {
+    int stopped;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif  // _OPENMP
+    stopped = p_solution->m_stopped;
+    if (stopped || (m_maxDepth != 0 && depth > m_maxDepth)) {
+      delete p_tableau;
+      return;
+    }
+
+    bool isNew = true;
+    if (depth > 0) {
+      p_tableau->LemkePath(j);
+#ifdef _OPENMP
+#pragma omp critical(gambit_lcp_solution)
+#endif  // _OPENMP
+      {
+	try {
+	  isNew = !p_solution->m_stopped && OnBFS(*p_game, *p_tableau, *p_solution);
+	}
+	catch (EquilibriumLimitReached &) {
+	  isNew = false;
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif  // _OPENMP
+	  p_solution->m_stopped = 1;
+	}
+      }
+    }
+
+    for (int i = p_tableau->MinCol(); isNew && i <= p_tableau->MaxCol(); i++) {
+      if (i != j) {
+	linalg::LHTableau<T> *copy = new linalg::LHTableau<T>(*p_tableau);
+	copy->Detach();
+#ifdef _OPENMP
+#pragma omp task firstprivate(p_game, copy, p_solution, i, depth)
+#endif  // _OPENMP
+	ParallelLemke(p_game, i, copy, p_solution, depth+1);
+      }
+    }
+  }
+  catch (std::runtime_error &e) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_lcp_solution)
+#endif  // _OPENMP
+    {
+      if (p_solution->m_error.empty()) {
+	p_solution->m_error = e.what();
+      }
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif  // _OPENMP
+      p_solution->m_stopped = 1;
+    }
+  }
+  delete p_tableau;
+}
+
 template <class T> List<MixedStrategyProfile<T> > 
 NashLcpStrategySolver<T>::Solve(const Game &p_game) const
 {
@@ -236,16 +314,36 @@ NashLcpStrategySolver<T>::Solve(const Game &p_game) const
   if (!p_game->IsPerfectRecall()) {
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
+  // Pivoting in exact arithmetic churns through many Integer temporaries
+  IntegerArena arena;
   Solution solution;
 
   try {
-    Matrix<T> A1 = Make_A1<T>(p_game);
+    BimatrixGame bimatrix(p_game);
+    Matrix<T> A1 = Make_A1<T>(bimatrix);
     Vector<T> b1 = Make_b1<T>(p_game);
-    Matrix<T> A2 = Make_A2<T>(p_game);
+    Matrix<T> A2 = Make_A2<T>(bimatrix);
     Vector<T> b2 = Make_b2<T>(p_game);
     linalg::LHTableau<T> B(A1, A2, b1, b2);
 
-    if (m_stopAfter != 1) {
+    if (m_stopAfter != 1 && m_numThreads > 1) {
+      linalg::LHTableau<T> *start = new linalg::LHTableau<T>(B);
+      start->Detach();
+#ifdef _OPENMP
+#pragma omp parallel num_threads(m_numThreads)
+#endif  // _OPENMP
+      {
+	IntegerArena threadArena;
+#ifdef _OPENMP
+#pragma omp single
+#endif  // _OPENMP
+	ParallelLemke(&p_game, 0, start, &solution, 0);
+      }
+      if (!solution.m_error.empty()) {
+	std::cerr << "ERROR: " << solution.m_error << std::endl;
+      }
+    }
+    else if (m_stopAfter != 1) {
       AllLemke(p_game, 0, B, solution, 0);
     }
     else  {
@@ -266,6 +364,323 @@ NashLcpStrategySolver<T>::Solve(const Game &p_game) const
 template class NashLcpStrategySolver<double>;
 template class NashLcpStrategySolver<Rational>;
 
+//========================================================================
+//                   class NashLcpHybridStrategySolver
+//========================================================================
+
+namespace {
+
+//
+// Solves M x = v exactly, leaving the solution in v.  The system is
+// first scaled to integers, and then eliminated fraction-free (Bareiss),
+// so that intermediate entries stay no larger than the minors of the
+// system; only the back substitution is done in rationals.  Returns
+// false if M is singular.
+//
+bool SolveExact(const Matrix<Rational> &M, Vector<Rational> &v)
+{
+  int k = v.Length();
+  Integer scale(1);
+  for (int r = 1; r <= k; r++) {
+    for (int c = 1; c <= k; c++)  scale = lcm(scale, M(r, c).denominator());
+    scale = lcm(scale, v[r].denominator());
+  }
+
+  // Row r of the augmented matrix [M | v] is held in E[r-1]
+  std::vector<std::vector<Integer> > E(k, std::vector<Integer>(k + 1));
+  for (int r = 1; r <= k; r++) {
+    for (int c = 1; c <= k; c++) {
+      E[r-1][c-1] = M(r, c).numerator() * (scale / M(r, c).denominator());
+    }
+    E[r-1][k] = v[r].numerator() * (scale / v[r].denominator());
+  }
+
+  Integer previous(1);
+  for (int c = 0; c < k; c++) {
+    int p = c;
+    while (p < k && sign(E[p][c]) == 0)  p++;
+    if (p == k)  return false;
+    if (p != c)  E[p].swap(E[c]);
+    for (int r = c + 1; r < k; r++) {
+      for (int cc = c + 1; cc <= k; cc++) {
+	E[r][cc] = (E[c][c] * E[r][cc] - E[r][c] * E[c][cc]) / previous;
+      }
+    }
+    previous = E[c][c];
+  }
+
+  for (int r = k - 1; r >= 0; r--) {
+    Rational x(E[r][k]);
+    for (int cc = r + 1; cc < k; cc++)  x -= Rational(E[r][cc]) * v[cc+1];
+    v[r+1] = x / Rational(E[r][r]);
+  }
+  return true;
+}
+
+//
+// Computes exactly the basic solution of one half of the Lemke-Howson
+// tableau, with constraints p_A and right-hand side p_b, in the
+// complementary basis whose positive labels are p_basis.  A row of p_A
+// has its slack basic unless its own label is in the basis, so the
+// regular columns in the basis are solved for on the remaining rows,
+// and the slacks then follow.  The values of the regular columns are
+// added to p_cbfs.  Returns false if the basis is singular or is not
+// feasible, that is, if some basic variable is positive.
+//
+bool CertifyBasis(const Matrix<Rational> &p_A, const Vector<Rational> &p_b,
+		  const std::vector<int> &p_basis, linalg::BFS<Rational> &p_cbfs)
+{
+  std::vector<int> rows, cols;
+  for (size_t i = 0; i < p_basis.size(); i++) {
+    if (p_basis[i] >= p_A.MinRow() && p_basis[i] <= p_A.MaxRow()) {
+      rows.push_back(p_basis[i]);
+    }
+    else if (p_basis[i] >= p_A.MinCol() && p_basis[i] <= p_A.MaxCol()) {
+      cols.push_back(p_basis[i]);
+    }
+  }
+  if (rows.size() != cols.size())  return false;
+
+  int k = rows.size();
+  Vector<Rational> y(1, k);
+  if (k > 0) {
+    Matrix<Rational> M(1, k, 1, k);
+    for (int r = 1; r <= k; r++) {
+      for (int c = 1; c <= k; c++)  M(r, c) = p_A(rows[r-1], cols[c-1]);
+      y[r] = p_b[rows[r-1]];
+    }
+    if (!SolveExact(M, y))  return false;
+    for (int c = 1; c <= k; c++) {
+      if (y[c] > Rational(0))  return false;
+    }
+  }
+
+  for (int r = p_A.MinRow(); r <= p_A.MaxRow(); r++) {
+    if (std::binary_search(p_basis.begin(), p_basis.end(), r))  continue;
+    Rational slack = p_b[r];
+    for (int c = 1; c <= k; c++)  slack -= p_A(r, cols[c-1]) * y[c];
+    if (slack > Rational(0))  return false;
+  }
+
+  for (int c = 1; c <= k; c++)  p_cbfs.insert(cols[c-1], y[c]);
+  return true;
+}
+
+//
+// Follows the Lemke path for label p_dup, as LHTableau::LemkePath()
+// does, but returns false if the path breaks down in floating point.
+// In degenerate games, rounding can defeat the lexicographic rule that
+// keeps the path from cycling, so each basis along the path is
+// recorded, and the path is abandoned if one recurs; it is also
+// abandoned if it reaches a column with no row to leave.
+//
+bool FollowPath(linalg::LHTableau<double> &p_tableau, int p_dup)
+{
+  std::set<std::vector<int> > visited;
+  std::vector<int> basis(p_tableau.MaxRow() - p_tableau.MinRow() + 1);
+  int enter = (p_tableau.Member(p_dup)) ? -p_dup : p_dup;
+  int exit;
+  do {
+    exit = p_tableau.PivotIn(enter);
+    if (exit == 0)  return false;
+    for (int row = p_tableau.MinRow(); row <= p_tableau.MaxRow(); row++) {
+      basis[row - p_tableau.MinRow()] = p_tableau.Label(row);
+    }
+    std::sort(basis.begin(), basis.end());
+    if (!visited.insert(basis).second)  return false;
+    enter = -exit;
+  } while (exit != p_dup && exit != -p_dup);
+  return true;
+}
+
+}  // end anonymous namespace
+
+class NashLcpHybridStrategySolver::Solution {
+public:
+  // The exact tableau data, used to certify bases and to pivot exactly
+  Matrix<Rational> m_A1, m_A2;
+  Vector<Rational> m_b1, m_b2;
+  Gambit::linalg::BasisSet m_visited;
+  List<MixedStrategyProfile<Rational> > m_equilibria;
+
+  Solution(const Game &p_game, const BimatrixGame &p_bimatrix)
+    : m_A1(Make_A1<Rational>(p_bimatrix)), m_A2(Make_A2<Rational>(p_bimatrix)),
+      m_b1(Make_b1<Rational>(p_game)), m_b2(Make_b2<Rational>(p_game)) { }
+
+  /// Computes the exact solution in the complementary basis with
+  /// positive labels p_basis; returns false if it is not feasible
+  bool Certify(const std::vector<int> &p_basis,
+	       linalg::BFS<Rational> &p_cbfs) const
+  {
+    return (CertifyBasis(m_A1, m_b1, p_basis, p_cbfs) &&
+	    CertifyBasis(m_A2, m_b2, p_basis, p_cbfs));
+  }
+
+  /// Pivots the exact tableau p_tableau into the complementary basis
+  /// with positive labels p_basis, which must have been certified
+  void PivotTo(linalg::LHTableau<Rational> &p_tableau,
+	       const std::vector<int> &p_basis) const;
+};
+
+void
+NashLcpHybridStrategySolver::Solution::PivotTo(linalg::LHTableau<Rational> &p_tableau,
+					       const std::vector<int> &p_basis) const
+{
+  for (size_t i = 0; i < p_basis.size(); i++) {
+    int inlabel = p_basis[i];
+    if (p_tableau.Member(inlabel))  continue;
+    // Labels of the first player's strategies are columns of the second
+    // player's half of the tableau, and vice versa
+    const Matrix<Rational> &A = (inlabel <= m_A1.MaxRow()) ? m_A2 : m_A1;
+    for (int row = A.MinRow(); row <= A.MaxRow(); row++) {
+      int outlabel = p_tableau.Label(row);
+      bool leaves = (outlabel > 0) ?
+	!std::binary_search(p_basis.begin(), p_basis.end(), outlabel) :
+	std::binary_search(p_basis.begin(), p_basis.end(), -outlabel);
+      if (leaves && p_tableau.CanPivot(outlabel, inlabel)) {
+	p_tableau.Pivot(row, inlabel);
+	break;
+      }
+    }
+  }
+}
+
+//
+// Function called when a CBFS has been computed exactly.  As in
+// NashLcpStrategySolver, returns 'true' if the CBFS is new; 'false' if
+// it has been visited.
+//
+bool
+NashLcpHybridStrategySolver::OnBFS(const Game &p_game,
+				   const linalg::BFS<Rational> &p_cbfs,
+				   Solution &p_solution) const
+{
+  if (!p_solution.m_visited.Insert(p_cbfs)) {
+    return false;
+  }
+
+  MixedStrategyProfile<Rational> profile(p_game->NewMixedStrategyProfile(Rational(0)));
+  if (!BFSToProfile(p_game, p_cbfs, profile)) {
+    return false;
+  }
+
+  m_onEquilibrium->Render(profile);
+  p_solution.m_equilibria.push_back(profile);
+
+  if (m_stopAfter > 0 && (int) p_solution.m_equilibria.size() >= m_stopAfter) {
+    throw EquilibriumLimitReached();
+  }
+
+  return true;
+}
+
+//
+// AllLemke follows each path out of the CBFS of B, whose basis p_basis
+// has been certified, in floating point.  A path which ends at a basis
+// that certifies is continued in the same way; otherwise, the path is
+// followed again in exact arithmetic from p_basis, and the search below
+// it is done by ExactLemke.
+//
+void
+NashLcpHybridStrategySolver::AllLemke(const Game &p_game,
+				      int j, linalg::LHTableau<double> &B,
+				      const std::vector<int> &p_basis,
+				      Solution &p_solution, int depth) const
+{
+  if (m_maxDepth != 0 && depth + 1 > m_maxDepth) {
+    return;
+  }
+
+  for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
+    if (i == j)  continue;
+
+    linalg::LHTableau<double> Bcopy(B);
+    linalg::BFS<Rational> cbfs;
+    bool certified = false;
+    try {
+      if (FollowPath(Bcopy, i)) {
+	linalg::BFS<double> approx(Bcopy.GetBFS());
+	if (p_solution.m_visited.Contains(approx))  continue;
+	certified = p_solution.Certify(approx.BasicVariables(), cbfs);
+      }
+    }
+    catch (Exception &) {
+      certified = false;
+    }
+
+    if (certified) {
+      if (OnBFS(p_game, cbfs, p_solution)) {
+	AllLemke(p_game, i, Bcopy, cbfs.BasicVariables(), p_solution, depth+1);
+      }
+    }
+    else {
+      linalg::LHTableau<Rational> exact(p_solution.m_A1, p_solution.m_A2,
+					p_solution.m_b1, p_solution.m_b2);
+      p_solution.PivotTo(exact, p_basis);
+      exact.LemkePath(i);
+      ExactLemke(p_game, i, exact, p_solution, depth+1);
+    }
+  }
+}
+
+//
+// ExactLemke is AllLemke of NashLcpStrategySolver<Rational>, searching
+// from the CBFS of B in exact arithmetic.
+//
+void
+NashLcpHybridStrategySolver::ExactLemke(const Game &p_game,
+					int j, linalg::LHTableau<Rational> &B,
+					Solution &p_solution, int depth) const
+{
+  if (m_maxDepth != 0 && depth > m_maxDepth) {
+    return;
+  }
+
+  if (depth > 0 && !OnBFS(p_game, B.GetBFS(), p_solution)) {
+    return;
+  }
+
+  for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
+    if (i != j)  {
+      linalg::LHTableau<Rational> Bcopy(B);
+      Bcopy.LemkePath(i);
+      ExactLemke(p_game, i, Bcopy, p_solution, depth+1);
+    }
+  }
+}
+
+List<MixedStrategyProfile<Rational> >
+NashLcpHybridStrategySolver::Solve(const Game &p_game) const
+{
+  if (p_game->NumPlayers() != 2) {
+    throw UndefinedException("Method only valid for two-player games.");
+  }
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  IntegerArena arena;
+  BimatrixGame bimatrix(p_game);
+  Solution solution(p_game, bimatrix);
+
+  try {
+    Matrix<double> A1 = Make_A1<double>(bimatrix);
+    Vector<double> b1 = Make_b1<double>(p_game);
+    Matrix<double> A2 = Make_A2<double>(bimatrix);
+    Vector<double> b2 = Make_b2<double>(p_game);
+    linalg::LHTableau<double> B(A1, A2, b1, b2);
+    // The search starts from the trivial CBFS, which needs no certificate
+    AllLemke(p_game, 0, B, std::vector<int>(), solution, 0);
+  }
+  catch (EquilibriumLimitReached &) {
+    // This pseudo-exception requires no additional action;
+    // solution contains details of all equilibria found
+  }
+  catch (std::runtime_error &e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+  }
+  return solution.m_equilibria;
+}
+
 }  // end namespace Gambit::Nash
 }  // end namespace Gambit
 
@@ -21,10 +21,94 @@
 //
 
 #include "gambit/linalg/ludecomp.imp"
+#include "gambit/kernels.h"
 
 using namespace Gambit;
 using namespace Gambit::linalg;
 
+//
+// The inner loops of the floating-point decomposition run over rows of
+// the basis matrix and over whole eta vectors, using the vectorized
+// kernels.
+//
+
+namespace Gambit {
+
+namespace linalg {
+
+template<>
+void LUdecomp<double>::GaussElem(Matrix<double> &B, int row, int col)
+{
+  if (B(row, col) == 0.0) throw BadPivot();
+
+  double *pivot = B.RowData(row) + (col - B.MinCol());
+  int n = B.MaxCol() - col;
+
+  for (int j = 1; j <= n; j++) {
+    pivot[j] = pivot[j] / pivot[0];
+  }
+
+  for (int i = row + 1; i <= B.MaxRow(); i++) {
+    double *entry = B.RowData(i) + (col - B.MinCol());
+    if (entry[0] != 0.0 && n > 0) {
+      kernels::Axpy(-entry[0], pivot + 1, entry + 1, n);
+    }
+    entry[0] = 0.0;
+  }
+
+  pivot[0] = 1.0;
+}
+
+template<>
+void LUdecomp<double>::VectorEtaSolve(const Vector<double> &v,
+				      const EtaMatrix<double> &eta,
+				      Vector<double> &y) const
+{
+  if ( v.First() != y.First() || v.Last() != y.Last() ) throw DimensionException();
+
+  y = v;
+  const double *vp = &v[v.First()], *ep = &eta.etadata[v.First()];
+  int c = eta.col - v.First(), n = v.Length();
+  double sum = (kernels::Dot(vp, ep, c) + 
+		kernels::Dot(vp + c + 1, ep + c + 1, n - c - 1));
+  y[eta.col] = (v[eta.col] - sum) / eta.etadata[eta.col];
+}
+
+template<>
+void LUdecomp<double>::EtaVectorSolve(const Vector<double> &v,
+				      const EtaMatrix<double> &eta,
+				      Vector<double> &d) const
+{
+  if ( v.First() != d.First() || v.Last() != d.Last() ) throw DimensionException();
+  if ( eta.etadata[eta.col] == 0.0 )
+    throw BadPivot(); // or we would have a singular matrix
+
+  double temp = v[eta.col] / eta.etadata[eta.col];
+  d = v;
+  kernels::Axpy(-temp, &eta.etadata[v.First()], &d[v.First()], v.Length());
+  d[eta.col] = temp;
+}
+
+template<>
+void LUdecomp<double>::yLP_mult(const Vector<double> &y, int j,
+				Vector<double> &ans) const
+{
+  if ( ans.First() != y.First() || ans.Last() != y.Last() ) throw DimensionException();
+
+  int l = j + y.First() - 1;
+  ans = y;
+  ans[L[j].col] = kernels::Dot(&y[y.First()], &L[j].etadata[y.First()],
+			       y.Length());
+
+  double temp = ans[l];
+  ans[l] = ans[P[j]];
+  ans[P[j]] = temp;
+}
+
+}  // end namespace Gambit::linalg
+
+}  // end namespace Gambit
+
 template class EtaMatrix<double>;
 template class LUdecomp<double>;
 
@@ -0,0 +1,169 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/linalg/sparseinverse.cc
+// Product form of the inverse of a basis of sparse columns
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include "gambit/linalg/sparseinverse.h"
+
+namespace Gambit {
+namespace linalg {
+
+void SparseWork::Clear(void)
+{
+  for (size_t k = 0; k < m_pattern.size(); k++) {
+    m_value[m_pattern[k]] = 0.0;
+    m_used[m_pattern[k]] = 0;
+  }
+  m_pattern.clear();
+}
+
+//---------------------------------------------------------------------------
+//                         SparseInverse: Lifecycle
+//---------------------------------------------------------------------------
+
+SparseInverse::SparseInverse(int n)
+  : m_size(n), m_nonzeros(0), m_factorEtas(0), m_factorNonzeros(0)
+{
+  m_work.Resize(n);
+}
+
+bool SparseInverse::IsStale(void) const
+{
+  return (m_etas.size() >= m_factorEtas + s_refactorInterval ||
+	  m_nonzeros > 2 * m_factorNonzeros + m_size);
+}
+
+//---------------------------------------------------------------------------
+//                          SparseInverse: Solving
+//---------------------------------------------------------------------------
+
+void SparseInverse::Solve(SparseWork &p_x) const
+{
+  for (size_t e = 0; e < m_etas.size(); e++) {
+    const Eta &eta = m_etas[e];
+    double x = p_x.m_value[eta.m_row];
+    if (x == 0.0)  continue;
+    x /= eta.m_pivot;
+    p_x.m_value[eta.m_row] = x;
+    for (size_t k = 0; k < eta.m_index.size(); k++) {
+      p_x.Add(eta.m_index[k], -eta.m_value[k] * x);
+    }
+  }
+}
+
+//
+// The eta matrices are applied in reverse order; each changes only the
+// entry of the row vector in its own row.
+//
+void SparseInverse::SolveTranspose(SparseWork &p_y) const
+{
+  for (size_t e = m_etas.size(); e-- > 0; ) {
+    const Eta &eta = m_etas[e];
+    double y = p_y.m_value[eta.m_row];
+    for (size_t k = 0; k < eta.m_index.size(); k++) {
+      y -= eta.m_value[k] * p_y.m_value[eta.m_index[k]];
+    }
+    if (y != 0.0 || p_y.m_used[eta.m_row]) {
+      p_y.Set(eta.m_row, y / eta.m_pivot);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+//                      SparseInverse: Changing the basis
+//---------------------------------------------------------------------------
+
+void SparseInverse::Update(int p_row, const SparseWork &p_solved)
+{
+  m_etas.push_back(Eta());
+  Eta &eta = m_etas.back();
+  eta.m_row = p_row;
+  eta.m_pivot = p_solved.m_value[p_row];
+  for (size_t k = 0; k < p_solved.m_pattern.size(); k++) {
+    int i = p_solved.m_pattern[k];
+    if (i != p_row && p_solved.m_value[i] != 0.0) {
+      eta.m_index.push_back(i);
+      eta.m_value.push_back(p_solved.m_value[i]);
+    }
+  }
+  m_nonzeros += eta.m_index.size() + 1;
+}
+
+void SparseInverse::Factor(const std::vector<char> &p_slacks,
+			   const std::vector<const SparseColumn *> &p_columns,
+			   std::vector<int> &p_rows)
+{
+  std::vector<char> open(m_size + 1, 1);
+  for (int i = 1; i <= m_size; i++) {
+    if (p_slacks[i])  open[i] = 0;
+  }
+  std::vector<std::pair<size_t, int> > order;
+  for (size_t s = 0; s < p_columns.size(); s++) {
+    order.push_back(std::make_pair(p_columns[s]->size(), (int) s));
+  }
+  std::sort(order.begin(), order.end());
+
+  // The number of entries in each row among the columns still to be
+  // brought in, as a guide to which rows will fill in least
+  std::vector<int> counts(m_size + 1, 0);
+  for (size_t s = 0; s < p_columns.size(); s++) {
+    const SparseColumn &column = *p_columns[s];
+    for (size_t k = 0; k < column.size(); k++)  counts[column[k].first]++;
+  }
+
+  m_etas.clear();
+  m_nonzeros = 0;
+  p_rows.assign(p_columns.size(), 0);
+  for (size_t s = 0; s < order.size(); s++) {
+    const SparseColumn &column = *p_columns[order[s].second];
+    for (size_t k = 0; k < column.size(); k++)  counts[column[k].first]--;
+    m_work.Add(column);
+    Solve(m_work);
+    double largest = 0.0;
+    for (size_t k = 0; k < m_work.m_pattern.size(); k++) {
+      int i = m_work.m_pattern[k];
+      if (open[i])  largest = std::max(largest, std::fabs(m_work.m_value[i]));
+    }
+    int row = 0;
+    for (size_t k = 0; k < m_work.m_pattern.size(); k++) {
+      int i = m_work.m_pattern[k];
+      if (open[i] && std::fabs(m_work.m_value[i]) >= 0.1 * largest &&
+	  largest > 0.0 && (row == 0 || counts[i] < counts[row])) {
+	row = i;
+      }
+    }
+    if (row == 0) {
+      m_work.Clear();
+      throw SingularBasis();
+    }
+    Update(row, m_work);
+    m_work.Clear();
+    open[row] = 0;
+    p_rows[order[s].second] = row;
+  }
+  m_factorEtas = m_etas.size();
+  m_factorNonzeros = m_nonzeros;
+}
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
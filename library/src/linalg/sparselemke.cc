@@ -0,0 +1,303 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/linalg/sparselemke.cc
+// Lemke tableau over a sparse matrix, in floating point
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include "gambit/linalg/btableau.h"
+#include "gambit/linalg/sparselemke.h"
+
+namespace Gambit {
+namespace linalg {
+
+//---------------------------------------------------------------------------
+//                   SparseLemkeTableau: Lifecycle
+//---------------------------------------------------------------------------
+
+SparseLemkeTableau::SparseLemkeTableau(const std::vector<SparseColumn> &p_columns,
+				       const Vector<double> &p_covering,
+				       const Vector<double> &p_b)
+  : m_size(p_b.Length()), m_columns(&p_columns),
+    m_b(m_size + 1, 0.0), m_numPivots(0),
+    m_label(m_size + 1, 0), m_row(2 * m_size + 1, 0),
+    m_inverse(m_size), m_solution(m_size + 1, 0.0)
+{
+  epsilon(m_eps);
+  for (int i = 1; i <= m_size; i++) {
+    m_covering.push_back(std::make_pair(i, p_covering[i]));
+    m_b[i] = p_b[i];
+    m_label[i] = -i;
+    m_row[m_size - i] = i;
+  }
+  m_incol.Resize(m_size);
+  m_col.Resize(m_size);
+  SolveBasis();
+}
+
+//---------------------------------------------------------------------------
+//                  SparseLemkeTableau: Linear algebra
+//---------------------------------------------------------------------------
+
+//
+// Computes the column of the label in terms of the current basis.
+//
+void SparseLemkeTableau::Solve(int p_label, SparseWork &p_work) const
+{
+  if (p_label > 0) {
+    p_work.Add((*m_columns)[p_label]);
+  }
+  else if (p_label == 0) {
+    p_work.Add(m_covering);
+  }
+  else {
+    p_work.Add(-p_label, 1.0);
+  }
+  m_inverse.Solve(p_work);
+}
+
+//
+// Computes the row of the inverse of the basis.
+//
+void SparseLemkeTableau::SolveRow(int p_row, SparseWork &p_work) const
+{
+  p_work.Add(p_row, 1.0);
+  m_inverse.SolveTranspose(p_work);
+}
+
+void SparseLemkeTableau::SolveBasis(void)
+{
+  for (int i = 1; i <= m_size; i++) {
+    if (m_b[i] != 0.0)  m_incol.Add(i, m_b[i]);
+  }
+  m_inverse.Solve(m_incol);
+  std::fill(m_solution.begin(), m_solution.end(), 0.0);
+  for (size_t k = 0; k < m_incol.m_pattern.size(); k++) {
+    m_solution[m_incol.m_pattern[k]] = m_incol.m_value[m_incol.m_pattern[k]];
+  }
+  m_incol.Clear();
+}
+
+void SparseLemkeTableau::BasisVector(Vector<double> &p_out) const
+{
+  for (int i = 1; i <= m_size; i++)  p_out[i] = m_solution[i];
+}
+
+//---------------------------------------------------------------------------
+//                 SparseLemkeTableau: Pivoting operations
+//---------------------------------------------------------------------------
+
+void SparseLemkeTableau::Pivot(int p_outrow, int p_inlabel)
+{
+  if (p_outrow < 1 || p_outrow > m_size ||
+      p_inlabel < -m_size || p_inlabel > m_size) {
+    throw BadPivot();
+  }
+  Solve(p_inlabel, m_incol);
+  if (m_incol.m_value[p_outrow] == 0.0) {
+    m_incol.Clear();
+    throw BadPivot();
+  }
+  m_inverse.Update(p_outrow, m_incol);
+  m_incol.Clear();
+
+  m_row[m_label[p_outrow] + m_size] = 0;
+  m_label[p_outrow] = p_inlabel;
+  m_row[p_inlabel + m_size] = p_outrow;
+  m_numPivots++;
+
+  if (m_inverse.IsStale()) {
+    Refactor();
+  }
+  else {
+    SolveBasis();
+  }
+}
+
+void SparseLemkeTableau::Refactor(void)
+{
+  std::vector<char> slacks(m_size + 1, 0);
+  std::vector<int> labels;
+  for (int i = 1; i <= m_size; i++) {
+    if (m_label[i] < 0) {
+      slacks[-m_label[i]] = 1;
+    }
+    else {
+      labels.push_back(m_label[i]);
+    }
+  }
+  std::sort(labels.begin(), labels.end());
+  std::vector<const SparseColumn *> columns;
+  for (size_t k = 0; k < labels.size(); k++) {
+    columns.push_back((labels[k] > 0) ? &(*m_columns)[labels[k]] : &m_covering);
+  }
+
+  std::vector<int> rows;
+  try {
+    m_inverse.Factor(slacks, columns, rows);
+  }
+  catch (SparseInverse::SingularBasis &) {
+    throw BadPivot();
+  }
+
+  std::fill(m_row.begin(), m_row.end(), 0);
+  for (int i = 1; i <= m_size; i++) {
+    if (slacks[i])  m_label[i] = -i;
+  }
+  for (size_t k = 0; k < labels.size(); k++) {
+    m_label[rows[k]] = labels[k];
+  }
+  for (int i = 1; i <= m_size; i++) {
+    m_row[m_label[i] + m_size] = i;
+  }
+  SolveBasis();
+}
+
+int SparseLemkeTableau::SF_PivotIn(int p_inlabel)
+{
+  int outindex = SF_ExitIndex(p_inlabel);
+  if (outindex == 0) {
+    return p_inlabel;
+  }
+  int outlabel = Label(outindex);
+  Pivot(outindex, p_inlabel);
+  return outlabel;
+}
+
+//
+// As LemkeTableau<T>::SF_ExitIndex, the rows with positive entries in
+// the entering column are candidates, and ties in the ratio test are
+// broken lexicographically, by the basic solution and then by the
+// columns of the inverse of the basis in turn.
+//
+// The column of the inverse for a basic slack is a unit vector, so it
+// can at most rule out the candidate in the slack's row.  The other
+// columns are solved for one at a time, unless it is cheaper to solve
+// for the rows of the inverse for the remaining candidates instead.
+//
+int SparseLemkeTableau::SF_ExitIndex(int p_inlabel)
+{
+  Solve(p_inlabel, m_incol);
+  std::vector<int> best;
+  for (size_t k = 0; k < m_incol.m_pattern.size(); k++) {
+    int i = m_incol.m_pattern[k];
+    if (m_incol.m_value[i] > m_eps)  best.push_back(i);
+  }
+  if (best.empty()) {
+    m_incol.Clear();
+    return 0;
+  }
+  std::sort(best.begin(), best.end());
+
+  std::vector<double> ratios(best.size());
+  for (size_t k = 0; k < best.size(); k++) {
+    ratios[k] = m_solution[best[k]] / m_incol.m_value[best[k]];
+  }
+  double minimum = *std::min_element(ratios.begin(), ratios.end());
+  size_t kept = 0;
+  for (size_t k = 0; k < best.size(); k++) {
+    if (ratios[k] <= minimum + m_eps)  best[kept++] = best[k];
+  }
+  best.resize(kept);
+
+  int remaining = 0;
+  for (int i = 1; i <= m_size; i++) {
+    if (m_label[i] >= 0)  remaining++;
+  }
+  std::vector<std::vector<double> > rows;
+  for (int c = 1; best.size() > 1; c++) {
+    if (c > m_size) {
+      m_incol.Clear();
+      throw BadExitIndex();
+    }
+    if (Member(-c)) {
+      int row = Find(-c);
+      if (1.0 / m_incol.m_value[row] > m_eps) {
+	std::vector<int>::iterator pos = std::lower_bound(best.begin(),
+							  best.end(), row);
+	if (pos != best.end() && *pos == row) {
+	  if (!rows.empty()) {
+	    for (size_t k = pos - best.begin(); k + 1 < rows.size(); k++) {
+	      rows[k].swap(rows[k+1]);
+	    }
+	    rows.pop_back();
+	  }
+	  best.erase(pos);
+	}
+      }
+      continue;
+    }
+
+    if (rows.empty() &&
+	best.size() * m_inverse.NumNonzeros() < (size_t) remaining * m_inverse.NumEtas()) {
+      rows.resize(best.size());
+      for (size_t k = 0; k < best.size(); k++) {
+	SolveRow(best[k], m_col);
+	rows[k].assign(m_col.m_value.begin(), m_col.m_value.end());
+	m_col.Clear();
+      }
+    }
+    ratios.resize(best.size());
+    if (!rows.empty()) {
+      for (size_t k = 0; k < best.size(); k++) {
+	ratios[k] = rows[k][c] / m_incol.m_value[best[k]];
+      }
+    }
+    else {
+      Solve(-c, m_col);
+      for (size_t k = 0; k < best.size(); k++) {
+	ratios[k] = m_col.m_value[best[k]] / m_incol.m_value[best[k]];
+      }
+      m_col.Clear();
+    }
+    remaining--;
+
+    minimum = *std::min_element(ratios.begin(), ratios.end());
+    kept = 0;
+    for (size_t k = 0; k < best.size(); k++) {
+      if (ratios[k] <= minimum + m_eps) {
+	best[kept] = best[k];
+	if (!rows.empty())  rows[kept].swap(rows[k]);
+	kept++;
+      }
+    }
+    best.resize(kept);
+    if (!rows.empty())  rows.resize(kept);
+  }
+  m_incol.Clear();
+  return best[0];
+}
+
+int SparseLemkeTableau::SF_LCPPath(int p_dup)
+{
+  int enter = p_dup, exit;
+  do {
+    exit = SF_PivotIn(enter);
+    if (exit == enter) {
+      return 0;
+    }
+    enter = -exit;
+  } while (exit != 0);
+  return 1;
+}
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
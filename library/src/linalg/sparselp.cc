@@ -0,0 +1,619 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/linalg/sparselp.cc
+// Revised simplex method for sparse linear programs, in floating point
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include "gambit/linalg/btableau.h"
+#include "gambit/linalg/sparselp.h"
+
+namespace Gambit {
+namespace linalg {
+
+namespace {
+
+/// Number of consecutive degenerate pivots after which Bland's rule is used
+const int DEGENERATE_LIMIT = 50;
+/// Devex weights are reset once any grows beyond this
+const double WEIGHT_LIMIT = 1.0e6;
+
+}  // end anonymous namespace
+
+//---------------------------------------------------------------------------
+//                         SparseLPSolve: Lifecycle
+//---------------------------------------------------------------------------
+
+SparseLPSolve::SparseLPSolve(const std::vector<SparseColumn> &p_columns,
+			     const Vector<double> &b, const Vector<double> &c,
+			     int nequals)
+  : m_columns(p_columns), m_rows(b.Length()), m_structural(c.Length()),
+    m_equalities(nequals), m_b(m_rows + 1, 0.0), m_c(m_structural + 1, 0.0),
+    m_inverse(m_rows), m_y(m_rows + 1, 0.0),
+    m_optimal(false), m_feasible(true), m_bounded(true), m_numPivots(0),
+    m_cost(0.0), m_primal(c.Length()), m_dual(b.Length())
+{
+  // Tolerances for feasibility and optimality, and the smallest pivot
+  // the ratio test will accept
+  epsilon(m_eps, 9);
+  epsilon(m_pivotTol, 7);
+
+  for (int i = 1; i <= m_rows; i++) {
+    m_b[i] = b[i];
+  }
+  for (int j = 1; j <= m_structural; j++) {
+    m_c[j] = c[j];
+  }
+  m_work.Resize(m_rows);
+  m_row.Resize(m_rows);
+  Solve();
+}
+
+//
+// Solves the problem from the basis of slacks and artificials.
+//
+void SparseLPSolve::Solve(void)
+{
+  m_optimal = false;
+  m_feasible = true;
+  m_bounded = true;
+  m_numPivots = 0;
+
+  int num_inequals = m_rows - m_equalities;
+  m_variables = m_structural + m_rows;
+  m_artificials.clear();
+  m_head.assign(m_rows + 1, 0);
+  for (int i = 1; i <= m_rows; i++) {
+    if ((i <= num_inequals && m_b[i] >= 0.0) ||
+	(i > num_inequals && m_b[i] == 0.0)) {
+      m_head[i] = m_structural + i;
+    }
+    else {
+      m_artificials.push_back(SparseColumn(1, std::make_pair(i, (m_b[i] > 0.0) ? 1.0 : -1.0)));
+      m_head[i] = m_variables + m_artificials.size();
+    }
+  }
+  m_variables += m_artificials.size();
+
+  m_lower.assign(m_variables + 1, 0.0);
+  m_upper.assign(m_variables + 1, HUGE_VAL);
+  for (int i = num_inequals + 1; i <= m_rows; i++) {
+    m_upper[m_structural + i] = 0.0;
+  }
+  m_x.assign(m_variables + 1, 0.0);
+  m_status.assign(m_variables + 1, AT_LOWER);
+  for (int i = 1; i <= m_rows; i++) {
+    m_status[m_head[i]] = BASIC;
+  }
+  Refactor();
+
+  // Phase I: maximize minus the sum of the artificials
+  int firstArtificial = m_structural + m_rows + 1;
+  if (!m_artificials.empty()) {
+    std::vector<double> cost(m_variables + 1, 0.0);
+    for (int j = firstArtificial; j <= m_variables; j++) {
+      cost[j] = -1.0;
+    }
+    m_weights.assign(m_variables + 1, 1.0);
+    Optimize(cost);
+    double infeasibility = 0.0;
+    for (int j = firstArtificial; j <= m_variables; j++) {
+      infeasibility += m_x[j];
+    }
+    double tolerance;
+    epsilon(tolerance, 6);
+    if (infeasibility > tolerance) {
+      m_feasible = false;
+      return;
+    }
+    for (int j = firstArtificial; j <= m_variables; j++) {
+      m_upper[j] = 0.0;
+      if (m_status[j] != BASIC) {
+	m_status[j] = AT_LOWER;
+	m_x[j] = 0.0;
+      }
+    }
+  }
+
+  // Phase II
+  std::vector<double> cost;
+  GetCost(cost);
+  m_weights.assign(m_variables + 1, 1.0);
+  if (!Optimize(cost)) {
+    m_bounded = false;
+    return;
+  }
+  Finish(cost);
+}
+
+void SparseLPSolve::Resolve(void)
+{
+  if (!m_optimal) {
+    Solve();
+    return;
+  }
+  m_optimal = false;
+  m_feasible = true;
+  m_bounded = true;
+  m_numPivots = 0;
+
+  try {
+    Refactor();
+  }
+  catch (SparseInverse::SingularBasis &) {
+    // A changed column has made the old basis singular
+    Solve();
+    return;
+  }
+
+  std::vector<double> cost;
+  GetCost(cost);
+  m_weights.assign(m_variables + 1, 1.0);
+  if (!IsPrimalFeasible()) {
+    // The costs of nonbasic variables whose reduced costs have the wrong
+    // sign are shifted, so the basis is optimal for the shifted costs,
+    // and the dual simplex method can restore feasibility
+    std::vector<double> shifted(cost);
+    ShiftCost(shifted);
+    if (!DualOptimize(shifted)) {
+      m_feasible = false;
+      return;
+    }
+  }
+  // The primal simplex method then goes on with the true costs
+  if (!Optimize(cost)) {
+    m_bounded = false;
+    return;
+  }
+  Finish(cost);
+}
+
+//
+// Computes the results from the optimal basis.
+//
+void SparseLPSolve::Finish(const std::vector<double> &p_cost)
+{
+  Refactor();
+  ComputeDual(p_cost);
+
+  m_cost = 0.0;
+  for (int j = 1; j <= m_structural; j++) {
+    m_primal[j] = (std::fabs(m_x[j]) > m_eps) ? m_x[j] : 0.0;
+    m_cost += m_c[j] * m_primal[j];
+  }
+  for (int i = 1; i <= m_rows; i++) {
+    m_dual[i] = (std::fabs(m_y[i]) > m_eps) ? m_y[i] : 0.0;
+  }
+  m_optimal = true;
+}
+
+void SparseLPSolve::GetCost(std::vector<double> &p_cost) const
+{
+  p_cost.assign(m_variables + 1, 0.0);
+  for (int j = 1; j <= m_structural; j++) {
+    p_cost[j] = m_c[j];
+  }
+}
+
+bool SparseLPSolve::IsPrimalFeasible(void) const
+{
+  for (int i = 1; i <= m_rows; i++) {
+    int v = m_head[i];
+    if (m_x[v] < m_lower[v] - m_eps || m_x[v] > m_upper[v] + m_eps) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SparseLPSolve::ShiftCost(std::vector<double> &p_cost)
+{
+  ComputeDual(p_cost);
+  for (int j = 1; j <= m_variables; j++) {
+    if (m_status[j] == BASIC || m_lower[j] == m_upper[j])  continue;
+    double d = p_cost[j] - DotColumn(j, m_y);
+    if ((m_status[j] == AT_LOWER && d > 0.0) ||
+	(m_status[j] == AT_UPPER && d < 0.0)) {
+      p_cost[j] -= d;
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+//                      SparseLPSolve: Columns of the LP
+//---------------------------------------------------------------------------
+
+const SparseColumn *SparseLPSolve::Column(int j) const
+{
+  if (j <= m_structural) {
+    return &m_columns[j];
+  }
+  else if (j <= m_structural + m_rows) {
+    return 0;
+  }
+  return &m_artificials[j - m_structural - m_rows - 1];
+}
+
+void SparseLPSolve::AddColumn(int j, double p_scale, SparseWork &p_work) const
+{
+  const SparseColumn *column = Column(j);
+  if (column) {
+    p_work.Add(*column, p_scale);
+  }
+  else {
+    p_work.Add(j - m_structural, p_scale);
+  }
+}
+
+double SparseLPSolve::DotColumn(int j, const std::vector<double> &p_y) const
+{
+  const SparseColumn *column = Column(j);
+  if (!column) {
+    return p_y[j - m_structural];
+  }
+  double sum = 0.0;
+  for (size_t k = 0; k < column->size(); k++) {
+    sum += (*column)[k].second * p_y[(*column)[k].first];
+  }
+  return sum;
+}
+
+//---------------------------------------------------------------------------
+//                      SparseLPSolve: Simplex iterations
+//---------------------------------------------------------------------------
+
+//
+// Reinverts the basis, and recomputes the values of the basic variables
+// from those of the nonbasic ones.
+//
+void SparseLPSolve::Refactor(void)
+{
+  std::vector<char> slacks(m_rows + 1, 0);
+  std::vector<const SparseColumn *> columns;
+  std::vector<int> variables;
+  for (int i = 1; i <= m_rows; i++) {
+    const SparseColumn *column = Column(m_head[i]);
+    if (column) {
+      columns.push_back(column);
+      variables.push_back(m_head[i]);
+    }
+    else {
+      slacks[m_head[i] - m_structural] = 1;
+    }
+  }
+
+  std::vector<int> rows;
+  m_inverse.Factor(slacks, columns, rows);
+  for (int i = 1; i <= m_rows; i++) {
+    if (slacks[i])  m_head[i] = m_structural + i;
+  }
+  for (size_t k = 0; k < variables.size(); k++) {
+    m_head[rows[k]] = variables[k];
+  }
+  ComputePrimal();
+}
+
+void SparseLPSolve::ComputePrimal(void)
+{
+  for (int i = 1; i <= m_rows; i++) {
+    if (m_b[i] != 0.0)  m_work.Add(i, m_b[i]);
+  }
+  for (int j = 1; j <= m_variables; j++) {
+    if (m_status[j] != BASIC && m_x[j] != 0.0) {
+      AddColumn(j, -m_x[j], m_work);
+    }
+  }
+  m_inverse.Solve(m_work);
+  for (int i = 1; i <= m_rows; i++) {
+    m_x[m_head[i]] = m_work.m_value[i];
+  }
+  m_work.Clear();
+}
+
+void SparseLPSolve::ComputeDual(const std::vector<double> &p_cost)
+{
+  for (int i = 1; i <= m_rows; i++) {
+    if (p_cost[m_head[i]] != 0.0)  m_work.Set(i, p_cost[m_head[i]]);
+  }
+  m_inverse.SolveTranspose(m_work);
+  for (int i = 1; i <= m_rows; i++) {
+    m_y[i] = m_work.m_value[i];
+  }
+  m_work.Clear();
+}
+
+//
+// Returns the entering variable, or zero if the basis is optimal.
+// Devex chooses the largest reduced cost relative to its weight, and
+// Bland's rule the eligible variable with smallest index.
+//
+int SparseLPSolve::Price(const std::vector<double> &p_cost, bool p_bland) const
+{
+  int entering = 0;
+  double best = 0.0;
+  for (int j = 1; j <= m_variables; j++) {
+    if (m_status[j] == BASIC || m_lower[j] == m_upper[j])  continue;
+    double d = p_cost[j] - DotColumn(j, m_y);
+    if ((m_status[j] == AT_LOWER && d > m_eps) ||
+	(m_status[j] == AT_UPPER && d < -m_eps)) {
+      if (p_bland)  return j;
+      if (d * d > best * m_weights[j]) {
+	entering = j;
+	best = d * d / m_weights[j];
+      }
+    }
+  }
+  return entering;
+}
+
+//
+// Runs the simplex method to optimality for the cost vector from the
+// current basis, returning false if the problem is unbounded.
+//
+// The ratio test is that of Harris: a first pass finds the largest step
+// which keeps the basic variables within their bounds, relaxed by the
+// feasibility tolerance, and a second pass chooses, among the variables
+// which would block a step that long, the one with the largest pivot.
+//
+bool SparseLPSolve::Optimize(const std::vector<double> &p_cost)
+{
+  int degenerate = 0;
+  while (true) {
+    if (m_inverse.IsStale()) {
+      Refactor();
+    }
+    ComputeDual(p_cost);
+    bool bland = (degenerate > DEGENERATE_LIMIT);
+    int q = Price(p_cost, bland);
+    if (q == 0) {
+      return true;
+    }
+    double dir = (m_status[q] == AT_LOWER) ? 1.0 : -1.0;
+
+    AddColumn(q, 1.0, m_work);
+    m_inverse.Solve(m_work);
+
+    double limit = HUGE_VAL;
+    for (size_t k = 0; k < m_work.m_pattern.size(); k++) {
+      int i = m_work.m_pattern[k];
+      double rate = -dir * m_work.m_value[i];
+      int v = m_head[i];
+      if (rate < -m_pivotTol && m_lower[v] > -HUGE_VAL) {
+	limit = std::min(limit, (m_x[v] - m_lower[v] + m_eps) / -rate);
+      }
+      else if (rate > m_pivotTol && m_upper[v] < HUGE_VAL) {
+	limit = std::min(limit, (m_upper[v] - m_x[v] + m_eps) / rate);
+      }
+    }
+
+    int r = 0;
+    double step = 0.0, pivot = 0.0;
+    for (size_t k = 0; k < m_work.m_pattern.size(); k++) {
+      int i = m_work.m_pattern[k];
+      double rate = -dir * m_work.m_value[i];
+      int v = m_head[i];
+      double ratio;
+      if (rate < -m_pivotTol && m_lower[v] > -HUGE_VAL) {
+	ratio = (m_x[v] - m_lower[v]) / -rate;
+      }
+      else if (rate > m_pivotTol && m_upper[v] < HUGE_VAL) {
+	ratio = (m_upper[v] - m_x[v]) / rate;
+      }
+      else {
+	continue;
+      }
+      if (ratio > limit)  continue;
+      if (r == 0 ||
+	  (bland && m_head[i] < m_head[r]) ||
+	  (!bland && std::fabs(rate) > pivot)) {
+	r = i;
+	step = ratio;
+	pivot = std::fabs(rate);
+      }
+    }
+    step = std::max(step, 0.0);
+
+    double flip = m_upper[q] - m_lower[q];
+    if (r == 0 && flip == HUGE_VAL) {
+      m_work.Clear();
+      return false;
+    }
+    if (r == 0 || flip <= step) {
+      // The entering variable reaches its other bound first
+      for (size_t k = 0; k < m_work.m_pattern.size(); k++) {
+	int i = m_work.m_pattern[k];
+	m_x[m_head[i]] -= dir * flip * m_work.m_value[i];
+      }
+      m_status[q] = (m_status[q] == AT_LOWER) ? AT_UPPER : AT_LOWER;
+      m_x[q] = (m_status[q] == AT_LOWER) ? m_lower[q] : m_upper[q];
+      m_work.Clear();
+      degenerate = 0;
+      continue;
+    }
+
+    for (size_t k = 0; k < m_work.m_pattern.size(); k++) {
+      int i = m_work.m_pattern[k];
+      m_x[m_head[i]] -= dir * step * m_work.m_value[i];
+    }
+    m_x[q] += dir * step;
+    int leaving = m_head[r];
+    if (-dir * m_work.m_value[r] < 0.0) {
+      m_status[leaving] = AT_LOWER;
+      m_x[leaving] = m_lower[leaving];
+    }
+    else {
+      m_status[leaving] = AT_UPPER;
+      m_x[leaving] = m_upper[leaving];
+    }
+
+    UpdateWeights(q, r);
+    m_inverse.Update(r, m_work);
+    m_work.Clear();
+    m_head[r] = q;
+    m_status[q] = BASIC;
+    m_numPivots++;
+    degenerate = (step > m_eps) ? 0 : degenerate + 1;
+  }
+}
+
+//
+// Runs the dual simplex method from a basis which is optimal for the
+// cost vector, until it is also feasible, returning false if the
+// problem is infeasible.
+//
+// The leaving variable is the basic variable furthest outside its
+// bounds, which is moved onto the bound it violates.  The entering
+// variable is chosen by a Harris ratio test on the reduced costs, so
+// that the basis stays optimal.
+//
+bool SparseLPSolve::DualOptimize(const std::vector<double> &p_cost)
+{
+  int degenerate = 0;
+  bool refactored = false;
+  std::vector<std::pair<int, double> > candidates;
+  while (true) {
+    if (m_inverse.IsStale()) {
+      Refactor();
+    }
+    bool bland = (degenerate > DEGENERATE_LIMIT);
+
+    int r = 0;
+    double worst = 0.0;
+    for (int i = 1; i <= m_rows; i++) {
+      int v = m_head[i];
+      double infeasibility = std::max(m_lower[v] - m_x[v], m_x[v] - m_upper[v]);
+      if (infeasibility > m_eps &&
+	  (r == 0 || (bland && v < m_head[r]) || (!bland && infeasibility > worst))) {
+	r = i;
+	worst = infeasibility;
+      }
+    }
+    if (r == 0) {
+      return true;
+    }
+    int leaving = m_head[r];
+    bool toLower = (m_x[leaving] < m_lower[leaving]);
+
+    ComputeDual(p_cost);
+    m_row.Add(r, 1.0);
+    m_inverse.SolveTranspose(m_row);
+    candidates.clear();
+    double limit = HUGE_VAL;
+    for (int j = 1; j <= m_variables; j++) {
+      if (m_status[j] == BASIC || m_lower[j] == m_upper[j])  continue;
+      double alpha = DotColumn(j, m_row.m_value);
+      // The direction in which the variable moves off its bound, and
+      // the resulting change in the leaving variable, must agree
+      double rate = (m_status[j] == AT_LOWER) ? -alpha : alpha;
+      if ((toLower && rate > m_pivotTol) || (!toLower && rate < -m_pivotTol)) {
+	double d = std::fabs(p_cost[j] - DotColumn(j, m_y));
+	candidates.push_back(std::make_pair(j, alpha));
+	limit = std::min(limit, (d + m_eps) / std::fabs(alpha));
+      }
+    }
+    m_row.Clear();
+    if (candidates.empty()) {
+      return false;
+    }
+
+    int q = 0;
+    double pivot = 0.0, dq = 0.0;
+    for (size_t k = 0; k < candidates.size(); k++) {
+      int j = candidates[k].first;
+      double alpha = std::fabs(candidates[k].second);
+      double d = std::fabs(p_cost[j] - DotColumn(j, m_y));
+      if (d / alpha > limit)  continue;
+      if (q == 0 || (bland && j < q) || (!bland && alpha > pivot)) {
+	q = j;
+	pivot = alpha;
+	dq = d;
+      }
+    }
+
+    AddColumn(q, 1.0, m_work);
+    m_inverse.Solve(m_work);
+    double alpha = m_work.m_value[r];
+    if (std::fabs(alpha) < m_pivotTol && !refactored) {
+      // The row and column computations disagree; try again from a new
+      // factorization
+      m_work.Clear();
+      Refactor();
+      refactored = true;
+      continue;
+    }
+    if (alpha == 0.0) {
+      m_work.Clear();
+      return false;
+    }
+    refactored = false;
+    double target = (toLower) ? m_lower[leaving] : m_upper[leaving];
+    double delta = (m_x[leaving] - target) / alpha;
+    for (size_t k = 0; k < m_work.m_pattern.size(); k++) {
+      int i = m_work.m_pattern[k];
+      m_x[m_head[i]] -= delta * m_work.m_value[i];
+    }
+    m_x[q] += delta;
+    m_x[leaving] = target;
+    m_status[leaving] = (toLower) ? AT_LOWER : AT_UPPER;
+
+    m_inverse.Update(r, m_work);
+    m_work.Clear();
+    m_head[r] = q;
+    m_status[q] = BASIC;
+    m_numPivots++;
+    degenerate = (dq > m_eps) ? 0 : degenerate + 1;
+  }
+}
+
+//
+// Updates the Devex reference weights for a pivot, using the pivot row,
+// computed from the row of the inverse of the basis.  The column of the
+// entering variable, solved against the basis, is in m_work.
+//
+void SparseLPSolve::UpdateWeights(int p_entering, int p_row)
+{
+  double pivot = m_work.m_value[p_row];
+  double weight = m_weights[p_entering];
+  m_row.Add(p_row, 1.0);
+  m_inverse.SolveTranspose(m_row);
+
+  bool reset = false;
+  for (int j = 1; j <= m_variables; j++) {
+    if (m_status[j] == BASIC || j == p_entering || m_lower[j] == m_upper[j]) {
+      continue;
+    }
+    double alpha = DotColumn(j, m_row.m_value);
+    if (alpha != 0.0) {
+      double ratio = alpha / pivot;
+      m_weights[j] = std::max(m_weights[j], ratio * ratio * weight);
+      reset = reset || m_weights[j] > WEIGHT_LIMIT;
+    }
+  }
+  m_weights[m_head[p_row]] = std::max(weight / (pivot * pivot), 1.0);
+  m_row.Clear();
+
+  if (reset) {
+    std::fill(m_weights.begin(), m_weights.end(), 1.0);
+  }
+}
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
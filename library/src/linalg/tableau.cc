@@ -121,6 +121,11 @@ void Tableau<double>::SetRefactor(int n)
   B.SetRefactor(n);
 }
 
+void Tableau<double>::Detach()
+{
+  B.Detach();
+}
+
 void Tableau<double>::SetConst(const Vector<double> &bnew)
 {
   if(bnew.First()!=b->First() || bnew.Last()!=b->Last())
@@ -200,8 +205,8 @@ Tableau<Rational>::Tableau(const Matrix<Rational> &A,
 			    const Vector<Rational> &b) 
   : TableauInterface<Rational>(A,b), 
     Tabdat(A.MinRow(),A.MaxRow(),A.MinCol(),A.MaxCol()),
-    Coeff(b.First(),b.Last()), denom(1), tmpcol(b.First(),b.Last()), 
-    nonbasic(A.MinCol(),A.MaxCol())
+    Coeff(b.First(),b.Last()), denom(1), m_small(false), m_smallDenom(1),
+    tmpcol(b.First(),b.Last()), nonbasic(A.MinCol(),A.MaxCol())
 {
   int j;
   for(j=MinCol();j<=MaxCol();j++) 
@@ -223,6 +228,7 @@ Tableau<Rational>::Tableau(const Matrix<Rational> &A,
     }
   for (int i = b.First();i<=b.Last();i++) 
     solution[i] = (Rational)Coeff[i];
+  Narrow();
 }
 
 Tableau<Rational>::Tableau(const Matrix<Rational> &A, 
@@ -230,8 +236,8 @@ Tableau<Rational>::Tableau(const Matrix<Rational> &A,
 			    const Vector<Rational> &b) 
   : TableauInterface<Rational>(A,art,b), 
     Tabdat(A.MinRow(),A.MaxRow(),A.MinCol(),A.MaxCol()+art.Length()),
-    Coeff(b.First(),b.Last()), denom(1), tmpcol(b.First(),b.Last()), 
-    nonbasic(A.MinCol(),A.MaxCol()+art.Length())
+    Coeff(b.First(),b.Last()), denom(1), m_small(false), m_smallDenom(1),
+    tmpcol(b.First(),b.Last()), nonbasic(A.MinCol(),A.MaxCol()+art.Length())
 {
   int j;
   for(j=MinCol();j<=MaxCol();j++) 
@@ -256,12 +262,15 @@ Tableau<Rational>::Tableau(const Matrix<Rational> &A,
   }
   for (int i = b.First();i<=b.Last();i++) 
     solution[i] = (Rational)Coeff[i];
+  Narrow();
 }
 
 
 Tableau<Rational>::Tableau(const Tableau<Rational> &orig) 
   : TableauInterface<Rational>(orig), Tabdat(orig.Tabdat), Coeff(orig.Coeff), 
     totdenom(orig.totdenom), denom(orig.denom), 
+    m_small(orig.m_small), m_smallTab(orig.m_smallTab),
+    m_smallCoeff(orig.m_smallCoeff), m_smallDenom(orig.m_smallDenom),
     tmpcol(orig.tmpcol), nonbasic(orig.nonbasic)
 { }
 
@@ -276,6 +285,10 @@ Tableau<Rational>& Tableau<Rational>::operator=(const Tableau<Rational> &orig)
     Coeff = orig.Coeff;
     totdenom = orig.totdenom;
     denom = orig.denom;
+    m_small = orig.m_small;
+    m_smallTab = orig.m_smallTab;
+    m_smallCoeff = orig.m_smallCoeff;
+    m_smallDenom = orig.m_smallDenom;
     tmpcol = orig.tmpcol;
     nonbasic = orig.nonbasic;
   }
@@ -292,6 +305,74 @@ int Tableau<Rational>::remap(int col_index) const
   return i;
 }
 
+//
+// The tableau is held in machine words for as long as all its entries
+// are small.  The product of two small entries, and the difference of
+// two such products, then fits in an int64_t, so each pivot is computed
+// exactly; once it produces an entry which is not small, the tableau
+// goes back to Integers (until Refactor() finds it small again).
+//
+void Tableau<Rational>::Narrow()
+{
+  if (!denom.is_small())  return;
+  for (int i = Coeff.First(); i <= Coeff.Last(); i++) {
+    if (!Coeff[i].is_small())  return;
+  }
+  for (int i = Tabdat.MinRow(); i <= Tabdat.MaxRow(); i++) {
+    for (int j = Tabdat.MinCol(); j <= Tabdat.MaxCol(); j++) {
+      if (!Tabdat(i,j).is_small())  return;
+    }
+  }
+
+  m_smallTab.resize(Tabdat.NumRows() * Tabdat.NumColumns());
+  m_smallCoeff.resize(Coeff.Length());
+  for (int i = Tabdat.MinRow(); i <= Tabdat.MaxRow(); i++) {
+    for (int j = Tabdat.MinCol(); j <= Tabdat.MaxCol(); j++) {
+      SmallEntry(i,j) = Tabdat(i,j).as_int64();
+    }
+  }
+  for (int i = Coeff.First(); i <= Coeff.Last(); i++) {
+    m_smallCoeff[i - Coeff.First()] = Coeff[i].as_int64();
+  }
+  m_smallDenom = denom.as_int64();
+  m_small = true;
+}
+
+void Tableau<Rational>::Widen()
+{
+  for (int i = Tabdat.MinRow(); i <= Tabdat.MaxRow(); i++) {
+    for (int j = Tabdat.MinCol(); j <= Tabdat.MaxCol(); j++) {
+      Tabdat(i,j).set_int64(SmallEntry(i,j));
+    }
+  }
+  for (int i = Coeff.First(); i <= Coeff.Last(); i++) {
+    Coeff[i].set_int64(m_smallCoeff[i - Coeff.First()]);
+  }
+  m_small = false;
+  m_smallTab.clear();
+  m_smallCoeff.clear();
+}
+
+// Column 'col' of the tableau, times the sign of denom*totdenom
+void Tableau<Rational>::GetTabColumn(int col, Vector<Rational> &out) const
+{
+  if (m_small) {
+    // totdenom is always positive
+    int64_t s = (m_smallDenom < 0) ? -1 : 1;
+    int stride = Tabdat.NumColumns();
+    const int64_t *x = &m_smallTab[col - Tabdat.MinCol()];
+    for (int i = out.First(); i <= out.Last(); i++, x += stride) {
+      out[i] = Rational((long) (*x * s));
+    }
+  }
+  else {
+    Rational s(sign(denom*totdenom));
+    for (int i = out.First(); i <= out.Last(); i++) {
+      out[i] = Rational(Tabdat(i,col)) * s;
+    }
+  }
+}
+
 Matrix<Rational> Tableau<Rational>::GetInverse()
 {
   Vector<Rational> mytmpcol(tmpcol.First(),tmpcol.Last());
@@ -340,50 +421,65 @@ void Tableau<Rational>::Pivot(int outrow,int in_col)
 
   col = remap(in_col);
 
-  // Pivot Algorithm:
-  // i* denotes Pivot Row
-  // j* denotes Pivot Column
-  // C is the Tableau
-  // Cij is the (i,j)th component of C
-  // X denotes multiplication
-  // d is the denominator (initially 1)
-  //
-  // 1: Copy row i (don't need to implement this)
-  // 2: Zero column j excepting the Pivot Element (done second)
-  // 3: Cij=(Ci*j*XCij-Ci*jXCij*)/d for all other elements (done first)
-  // 4: d=Ci*j* (done last)
-
-  // Step 3
+  if (m_small) {
+    SmallPivot(row, col);
+    if (!m_small)  Widen();
+  }
+  else {
+    // Pivot Algorithm:
+    // i* denotes Pivot Row
+    // j* denotes Pivot Column
+    // C is the Tableau
+    // Cij is the (i,j)th component of C
+    // X denotes multiplication
+    // d is the denominator (initially 1)
+    //
+    // 1: Copy row i (don't need to implement this)
+    // 2: Zero column j excepting the Pivot Element (done second)
+    // 3: Cij=(Ci*j*XCij-Ci*jXCij*)/d for all other elements (done first)
+    // 4: d=Ci*j* (done last)
+
+    // Step 3
   
-  for(i=Tabdat.MinRow();i<=Tabdat.MaxRow();++i){
-    if(i!=row){
-      for(j=Tabdat.MinCol();j<=Tabdat.MaxCol();++j){
-	if(j!=col){
-	  Tabdat(i,j) = (Tabdat(row,col)*Tabdat(i,j)-Tabdat(row,j)*Tabdat(i,col))/denom;
-	}
+    for(i=Tabdat.MinRow();i<=Tabdat.MaxRow();++i){
+      if(i!=row){
+        for(j=Tabdat.MinCol();j<=Tabdat.MaxCol();++j){
+	  if(j!=col){
+	    Tabdat(i,j) = (Tabdat(row,col)*Tabdat(i,j)-Tabdat(row,j)*Tabdat(i,col))/denom;
+	  }
+        }
+        Coeff[i] = (Tabdat(row,col)*Coeff[i]-Coeff[row]*Tabdat(i,col))/denom;
       }
-      Coeff[i] = (Tabdat(row,col)*Coeff[i]-Coeff[row]*Tabdat(i,col))/denom;
     }
+    // Step 2
+    // Note: here we are moving the old basis column into column 'col'
+    for(i=Tabdat.MinRow();i<=Tabdat.MaxRow();++i){
+      if(i!=row)
+        Tabdat(i,col)=-Tabdat(i,col);
+    }
+    // Step 4
+    Integer old_denom = denom;
+    denom=Tabdat(row,col);
+    Tabdat(row,col)=old_denom;
   }
-  // Step 2
-  // Note: here we are moving the old basis column into column 'col'
-  for(i=Tabdat.MinRow();i<=Tabdat.MaxRow();++i){
-    if(i!=row)
-      Tabdat(i,col)=-Tabdat(i,col);
-  }
-  // Step 4
-  Integer old_denom = denom;
-  denom=Tabdat(row,col);
-  Tabdat(row,col)=old_denom;
   // BigDump(gout);
   npivots++;
 
   basis.Pivot(outrow,in_col);
   nonbasic[col] = outlabel;
   
-  for (i = solution.First();i<=solution.Last();i++) 
-    //** solution[i] = (Rational)(Coeff[i])/(Rational)(denom*totdenom);
-    solution[i] = Rational(Coeff[i]*sign(denom*totdenom));
+  if (m_small) {
+    // totdenom is always positive
+    int64_t s = (m_smallDenom < 0) ? -1 : 1;
+    for (i = solution.First(); i <= solution.Last(); i++) {
+      solution[i] = Rational((long) (m_smallCoeff[i - Coeff.First()] * s));
+    }
+  }
+  else {
+    for (i = solution.First();i<=solution.Last();i++) 
+      //** solution[i] = (Rational)(Coeff[i])/(Rational)(denom*totdenom);
+      solution[i] = Rational(Coeff[i]*sign(denom*totdenom));
+  }
 
   //gout << "Bottom \n" << Tabdat << '\n';
   // BigDump(gout);
@@ -394,18 +490,64 @@ void Tableau<Rational>::Pivot(int outrow,int in_col)
   // Refactor();
 }
 
+//
+// The pivot of Pivot(), in machine words.  If any entry of the result is
+// not small, m_small is cleared; the entries are still exact, so the
+// caller can then widen them into Integers.
+//
+void Tableau<Rational>::SmallPivot(int row, int col)
+{
+  const int64_t bound = int64_t(1) << 31;
+  int ncols = Tabdat.NumColumns();
+  int pc = col - Tabdat.MinCol();
+  int64_t *pivotRow = &m_smallTab[(row - Tabdat.MinRow()) * ncols];
+  int64_t *coeff = &m_smallCoeff[0];
+  int64_t p = pivotRow[pc], d = m_smallDenom;
+  int64_t pcoeff = coeff[row - Tabdat.MinRow()];
+  bool small = true;
+
+  for (int i = Tabdat.MinRow(); i <= Tabdat.MaxRow(); i++) {
+    if (i == row)  continue;
+    int64_t *x = &m_smallTab[(i - Tabdat.MinRow()) * ncols];
+    int64_t &c = coeff[i - Tabdat.MinRow()];
+    int64_t q = x[pc];
+    if (q == 0) {
+      // The row is only scaled, by p/d
+      for (int j = 0; j < ncols; j++) {
+	if (x[j] != 0) {
+	  x[j] = (p * x[j]) / d;
+	  small = small && x[j] > -bound && x[j] < bound;
+	}
+      }
+      c = (p * c) / d;
+    }
+    else {
+      for (int j = 0; j < ncols; j++) {
+	if (j != pc) {
+	  x[j] = (p * x[j] - pivotRow[j] * q) / d;
+	  small = small && x[j] > -bound && x[j] < bound;
+	}
+      }
+      c = (p * c - pcoeff * q) / d;
+      x[pc] = -q;
+    }
+    small = small && c > -bound && c < bound;
+  }
+
+  m_smallDenom = p;
+  denom.set_int64(p);
+  pivotRow[pc] = d;
+  m_small = small;
+}
+
 void Tableau<Rational>::SolveColumn(int in_col, Vector<Rational> &out)
 {
-  Vector<Integer> tempcol(tmpcol.First(),tmpcol.Last());
   if(Member(in_col)) {
     out = (Rational)0;
     out[Find(in_col)] = Rational(abs(denom));
   }
   else {
-    int col = remap(in_col);
-    Tabdat.GetColumn(col,tempcol);
-    for(int i=tempcol.First();i<=tempcol.Last();i++)
-      out[i] = (Rational)(tempcol[i]) * (Rational)(sign(denom*totdenom));
+    GetTabColumn(remap(in_col), out);
   }
   out=out/(Rational)abs(denom);
   if(in_col < 0) out*=totdenom;
@@ -415,16 +557,12 @@ void Tableau<Rational>::SolveColumn(int in_col, Vector<Rational> &out)
 
 void Tableau<Rational>::MySolveColumn(int in_col, Vector<Rational> &out)
 {
-  Vector<Integer> tempcol(tmpcol.First(),tmpcol.Last());
   if(Member(in_col)) {
     out = (Rational)0;
     out[Find(in_col)] = Rational(abs(denom));
   }
   else {
-    int col = remap(in_col);
-    Tabdat.GetColumn(col,tempcol);
-    for(int i=tempcol.First();i<=tempcol.Last();i++)
-      out[i] = (Rational)(tempcol[i]) * (Rational)(sign(denom*totdenom));
+    GetTabColumn(remap(in_col), out);
   }
 }
 
@@ -473,6 +611,8 @@ void Tableau<Rational>::Refactor()
       Tabdat(i,j) = Tabnew(i,j).numerator();
     }
   }
+  m_small = false;
+  Narrow();
   //BigDump(gout);
 }
   
@@ -499,14 +639,74 @@ void Tableau<Rational>::SetBasis(const Basis &in)
 void Tableau<Rational>::Solve(const Vector<Rational> &b, Vector<Rational> &x)
 {
   // Here, we do x = V * b, where V = M inverse
-  x = (GetInverse() * b )/(Rational)abs(denom);
+  if (!m_small) {
+    x = (GetInverse() * b )/(Rational)abs(denom);
+    return;
+  }
+  if (&x == &b) {
+    Vector<Rational> bcopy(b);
+    Solve(bcopy, x);
+    return;
+  }
+
+  // Column j of V*|denom| is the unit column in the row of the basic
+  // slack -j, or else the tableau column of -j; only columns with a
+  // nonzero entry in b are visited.
+  Rational d(abs(denom));
+  int64_t s = (m_smallDenom < 0) ? -1 : 1;
+  int stride = Tabdat.NumColumns();
+  x = (Rational) 0;
+  for (int j = b.First(); j <= b.Last(); j++) {
+    if (b[j] == (Rational) 0)  continue;
+    if (Member(-j)) {
+      x[Find(-j)] += b[j] * d;
+    }
+    else {
+      const int64_t *v = &m_smallTab[remap(-j) - Tabdat.MinCol()];
+      for (int i = x.First(); i <= x.Last(); i++, v += stride) {
+	if (*v != 0)  x[i] += b[j] * Rational((long) (*v * s));
+      }
+    }
+  }
+  x = x / d;
 }
 
  // solve y M = c
 void Tableau<Rational>::SolveT(const Vector<Rational> &c, Vector<Rational> &y)
 {
   // Here we do y = c * V, where V = M inverse
-  y = (c * GetInverse()) /(Rational)abs(denom);
+  if (!m_small) {
+    y = (c * GetInverse()) /(Rational)abs(denom);
+    return;
+  }
+  if (&y == &c) {
+    Vector<Rational> ccopy(c);
+    SolveT(ccopy, y);
+    return;
+  }
+
+  // As in Solve(), but only the nonzero entries of c enter the products
+  Rational d(abs(denom));
+  int64_t s = (m_smallDenom < 0) ? -1 : 1;
+  int stride = Tabdat.NumColumns();
+  std::vector<int> support;
+  for (int i = c.First(); i <= c.Last(); i++) {
+    if (c[i] != (Rational) 0)  support.push_back(i);
+  }
+  for (int j = y.First(); j <= y.Last(); j++) {
+    if (Member(-j)) {
+      y[j] = c[Find(-j)];
+    }
+    else {
+      const int64_t *v = &m_smallTab[remap(-j) - Tabdat.MinCol()];
+      Rational sum(0);
+      for (size_t k = 0; k < support.size(); k++) {
+	int64_t entry = v[(support[k] - Tabdat.MinRow()) * stride];
+	if (entry != 0)  sum += c[support[k]] * Rational((long) (entry * s));
+      }
+      y[j] = sum / d;
+    }
+  }
 }
 
 bool Tableau<Rational>::IsFeasible()
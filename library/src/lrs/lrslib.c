@@ -29,20 +29,21 @@
 /* Globals; these need to be here, rather than lrslib.h, so they are
    not multiply defined. */
 
-FILE *lrs_cfp;			/* output file for checkpoint information       */
-FILE *lrs_ifp;			/* input file pointer       */
-FILE *lrs_ofp;			/* output file pointer      */
+/* These are per thread; the dictionary cache counters are kept   */
+/* in each lrs_dat.                                                */
 
+LRS_THREAD_LOCAL FILE *lrs_cfp;			/* output file for checkpoint information       */
+LRS_THREAD_LOCAL FILE *lrs_ifp;			/* input file pointer       */
+LRS_THREAD_LOCAL FILE *lrs_ofp;			/* output file pointer      */
 
-static unsigned long dict_count, dict_limit, cache_tries, cache_misses;
 
 /* Variables and functions global to this file only */
-static long lrs_checkpoint_seconds = 0;
+static LRS_THREAD_LOCAL long lrs_checkpoint_seconds = 0;
 
-static long lrs_global_count = 0;	/* Track how many lrs_dat records are 
+static LRS_THREAD_LOCAL long lrs_global_count = 0;	/* Track how many lrs_dat records are 
 					   allocated */
 
-static lrs_dat_p *lrs_global_list[MAX_LRS_GLOBALS + 1];
+static LRS_THREAD_LOCAL lrs_dat_p *lrs_global_list[MAX_LRS_GLOBALS + 1];
 
 static lrs_dic *new_lrs_dic (long m, long d, long m_A);
 
@@ -1116,7 +1117,6 @@ lrs_init (const char *name)       /* returns TRUE if successful, else FALSE */
 #endif // LRS_LOGGING
 
 
-  lrs_global_count = 0;
   lrs_checkpoint_seconds = 0;
 #ifdef SIGNALS
   setup_signals ();
@@ -1233,6 +1233,10 @@ lrs_alloc_dat (const char *name)
   Q->etrace = -1L;		/* turn off debug at basis # etrace */
 
   Q->saved_flag = 0;		/* no cobasis saved initially, db */
+  Q->dict_count = 1;
+  Q->dict_limit = 50;		/* may be changed by cache option */
+  Q->cache_tries = 0;
+  Q->cache_misses = 0;
   lrs_alloc_mp (Q->Nvolume);
   lrs_alloc_mp (Q->Dvolume);
   lrs_alloc_mp (Q->sumdet);
@@ -1675,11 +1679,11 @@ lrs_read_dic (lrs_dic * P, lrs_dat * Q)
 
       if (strcmp (name, "cache") == 0)
 	{
-	  if(fscanf (lrs_ifp, "%ld", &dict_limit)==EOF)
-              dict_limit=1;
-	  fprintf (lrs_ofp, "\n*cache %ld", dict_limit);
-	  if (dict_limit < 1)
-	    dict_limit = 1;
+	  if(fscanf (lrs_ifp, "%ld", &Q->dict_limit)==EOF)
+              Q->dict_limit=1;
+	  fprintf (lrs_ofp, "\n*cache %ld", Q->dict_limit);
+	  if (Q->dict_limit < 1)
+	    Q->dict_limit = 1;
 	}
       if (strcmp (name, "linearity") == 0)
 	{
@@ -3084,9 +3088,9 @@ lrs_printtotals (lrs_dic * P, lrs_dat * Q)
 
     }				/* end of output for vertices/rays */
 
-  fprintf (lrs_ofp, "\n*Dictionary Cache: max size= %ld misses= %ld/%ld   Tree Depth= %ld", dict_count, cache_misses, cache_tries, Q->deepest);
+  fprintf (lrs_ofp, "\n*Dictionary Cache: max size= %ld misses= %ld/%ld   Tree Depth= %ld", Q->dict_count, Q->cache_misses, Q->cache_tries, Q->deepest);
   if(lrs_ofp != stdout)
-      printf ("\n*Dictionary Cache: max size= %ld misses= %ld/%ld   Tree Depth= %ld", dict_count, cache_misses, cache_tries, Q->deepest);
+      printf ("\n*Dictionary Cache: max size= %ld misses= %ld/%ld   Tree Depth= %ld", Q->dict_count, Q->cache_misses, Q->cache_tries, Q->deepest);
 
   if(!Q->verbose)
      return;
@@ -4729,7 +4733,7 @@ static void
 cache_dict (lrs_dic ** D_p, lrs_dat * global, long i, long j)
 {
 
-  if (dict_limit > 1)
+  if (global->dict_limit > 1)
     {
       /* save row, column indicies */
       (*D_p)->i = i;
@@ -4818,7 +4822,7 @@ pushQ (lrs_dat * global, long m, long d ,long m_A)
   if ((global->Qtail->next) == global->Qhead)
     {
       /* the Queue is full */
-      if (dict_count < dict_limit)
+      if (global->dict_count < global->dict_limit)
 	{
 	  /* but we are allowed to create more */
 	  lrs_dic *p;
@@ -4835,7 +4839,7 @@ pushQ (lrs_dat * global, long m, long d ,long m_A)
 	      (global->Qtail->next) = p;
 	      p->prev = global->Qtail;
 
-	      dict_count++;
+	      global->dict_count++;
 	      global->Qtail = p;
 
 	      TRACE ("Added new record to Q");
@@ -4896,6 +4900,7 @@ lrs_dic *p;
   p->prev = p;
   Q->Qhead = p;
   Q->Qtail = p;
+  Q->dict_count = 1;
 
   return p;
 }
@@ -5044,13 +5049,13 @@ check_cache (lrs_dic ** D_p, lrs_dat * global, long *i_p, long *j_p)
 
 
 
-  cache_tries++;
+  global->cache_tries++;
 
   if (global->Qtail == global->Qhead)
     {
       TRACE ("cache miss");
       /* Q has only one element */
-      cache_misses++;
+      global->cache_misses++;
       return 0;
 
     }
@@ -5103,10 +5108,9 @@ lrs_alloc_dic (lrs_dat * Q)
   Q->Qtail = p;
 
 
-  dict_count = 1;
-  dict_limit = 50; 
-  cache_tries = 0;
-  cache_misses = 0;
+  Q->dict_count = 1;
+  Q->cache_tries = 0;
+  Q->cache_misses = 0;
 
 /* Initializations */
 
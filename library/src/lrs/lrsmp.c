@@ -28,8 +28,8 @@
 #include <string.h>
 #include "gambit/lrs/lrsmp.h"
 
-long lrs_digits;		/* max permitted no. of digits   */
-long lrs_record_digits;		/* this is the biggest acheived so far.     */
+LRS_THREAD_LOCAL long lrs_digits;		/* max permitted no. of digits   */
+LRS_THREAD_LOCAL long lrs_record_digits;		/* this is the biggest acheived so far.     */
 
 
 /******************************************************************/
@@ -154,6 +154,73 @@ lrs_clear_mp_matrix (lrs_mp_matrix p, long m, long n)
 /* Core library functions - depend on mp implementation  */
 /******************************************************* */
 
+/*********************************************************/
+/* 64 bit fast path: numbers of at most two digits, and  */
+/* three digit numbers below MAXD, fit in a long, so     */
+/* products and sums of them are formed in machine       */
+/* arithmetic with an overflow check, falling back to    */
+/* the multiple precision code on overflow.  Results are */
+/* identical either way.                                 */
+/*********************************************************/
+
+#define fitslong(a)	(length (a) <= 3 || \
+			 (length (a) == 4 && (a)[3] < MAXD / (BASE * BASE)))
+
+#if defined(__GNUC__) && __GNUC__ >= 5
+#define mul_overflow(x,y,r)	__builtin_mul_overflow ((x), (y), (r))
+#define add_overflow(x,y,r)	__builtin_add_overflow ((x), (y), (r))
+#else
+static long
+mul_overflow (long x, long y, long *r)
+{
+  if (x != 0 && labs (y) > MAXD / labs (x))
+    return TRUE;
+  *r = x * y;
+  return FALSE;
+}
+
+static long
+add_overflow (long x, long y, long *r)
+{
+  if ((y > 0 && x > MAXD - y) || (y < 0 && x < -MAXD - y))
+    return TRUE;
+  *r = x + y;
+  return FALSE;
+}
+#endif
+
+static long
+mptolong (lrs_mp a)		/* a must satisfy fitslong(a) */
+{
+  long i, x = 0;
+  for (i = length (a) - 1; i >= 1; i--)
+    x = x * BASE + a[i];
+  return (a[0] < 0) ? -x : x;
+}
+
+static void
+longtomp (long x, lrs_mp a)	/* |x| <= MAXD; unlike itomp, leaves */
+				/* digits beyond the length alone    */
+{
+  long i, sig = POS;
+  if (x < 0)
+    {
+      sig = NEG;
+      x = -x;
+    }
+  a[1] = x % BASE;
+  x /= BASE;
+  for (i = 2; x != 0; i++)
+    {
+      a[i] = x % BASE;
+      x /= BASE;
+    }
+  if (i > lrs_record_digits)
+    lrs_record_digits = i;
+  a[0] = (sig == NEG) ? -i : i;
+}
+
+
 void copy (lrs_mp a, lrs_mp b)	/* assigns a=b  */
 {
   long i;
@@ -173,6 +240,14 @@ divint (lrs_mp a, lrs_mp b, lrs_mp c)	/* c=a/b, a contains remainder on return *
   long cy, la, lb, lc, d1, s, t, sig;
   long i, j, qh;
 
+  if (fitslong (a) && fitslong (b))
+    {
+      long x = mptolong (a), y = mptolong (b);
+      longtomp (x / y, c);
+      longtomp (x % y, a);
+      return;
+    }
+
 /*  figure out and save sign, do everything with positive numbers */
   sig = sign (a) * sign (b);
 
@@ -332,20 +407,15 @@ gcd (lrs_mp u, lrs_mp v)	/*returns u=gcd(u,v) destroying v */
   lrs_mp r;
   unsigned long ul, vl;
   long i;
-  static unsigned long maxspval = MAXD;		/* Max value for the last digit to guarantee */
+  unsigned long maxspval = MAXD;		/* Max value for the last digit to guarantee */
   /* fitting into a single long integer. */
 
-  static long maxsplen;		/* Maximum digits for a number that will fit */
+  long maxsplen;		/* Maximum digits for a number that will fit */
   /* into a single long integer. */
 
-  static long firstime = TRUE;
-
-  if (firstime)			/* initialize constants */
-    {
-      for (maxsplen = 2; maxspval >= BASE; maxsplen++)
-	maxspval /= BASE;
-      firstime = FALSE;
-    }
+  /* computed on each call rather than cached, so gcd is reentrant */
+  for (maxsplen = 2; maxspval >= BASE; maxsplen++)
+    maxspval /= BASE;
   if (mp_greater (v, u))
     goto bigv;
 bigu:
@@ -493,6 +563,17 @@ linint (lrs_mp a, long ka, lrs_mp b, long kb)	/*compute a*ka+b*kb --> a */
 /***Handbook of Algorithms and Data Structures P.239 ***/
 {
   long i, la, lb;
+  if (fitslong (a) && fitslong (b))
+    {
+      long x, y, r;
+      if (!mul_overflow (mptolong (a), ka, &x) &&
+	  !mul_overflow (mptolong (b), kb, &y) &&
+	  !add_overflow (x, y, &r) && r >= -MAXD)
+	{
+	  longtomp (r, a);
+	  return;
+	}
+    }
   la = length (a);
   lb = length (b);
   for (i = 1; i < la; i++)
@@ -536,6 +617,15 @@ mulint (lrs_mp a, lrs_mp b, lrs_mp c)	/* multiply two integers a*b --> c */
 {
   long nlength, i, j, la, lb;
 /*** b and c may coincide ***/
+  if (fitslong (a) && fitslong (b))
+    {
+      long r;
+      if (!mul_overflow (mptolong (a), mptolong (b), &r) && r >= -MAXD)
+	{
+	  longtomp (r, c);
+	  return;
+	}
+    }
   la = length (a);
   lb = length (b);
   nlength = la + lb - 2;
@@ -976,6 +1066,13 @@ comprod (lrs_mp Na, lrs_mp Nb, lrs_mp Nc, lrs_mp Nd)	/* +1 if Na*Nb > Nc*Nd  */
 			  /*  0 if Na*Nb = Nc*Nd  */
 {
   lrs_mp mc, md;
+  if (fitslong (Na) && fitslong (Nb) && fitslong (Nc) && fitslong (Nd))
+    {
+      long x, y;
+      if (!mul_overflow (mptolong (Na), mptolong (Nb), &x) &&
+	  !mul_overflow (mptolong (Nc), mptolong (Nd), &y))
+	return (x > y) ? 1 : ((x < y) ? -1 : 0);
+    }
   mulint (Na, Nb, mc);
   mulint (Nc, Nd, md);
   linint (mc, ONE, md, -ONE);
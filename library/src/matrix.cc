@@ -22,9 +22,45 @@
 
 #include "gambit/gambit.h"
 #include "gambit/matrix.imp"
+#include "gambit/kernels.h"
 
 using namespace Gambit;
 
+namespace Gambit {
+
+template<>
+void Matrix<double>::CMultiply(const Vector<double> &in,
+			       Vector<double> &out) const
+{
+  if (!this->CheckRow(in) || !this->CheckColumn(out))  {
+    throw DimensionException();
+  }
+
+  const double *src2 = in.data + this->mincol;
+  int n = this->maxcol - this->mincol + 1;
+  for (int i = this->minrow; i <= this->maxrow; i++)   {
+    out[i] = kernels::Dot(this->data[i] + this->mincol, src2, n);
+  }
+}
+
+template<>
+void Matrix<double>::RMultiply(const Vector<double> &in,
+			       Vector<double> &out) const
+{
+  if (!this->CheckColumn(in) || !this->CheckRow(out)) {
+    throw DimensionException();
+  }
+
+  out = 0.0;
+  double *dst = out.data + this->mincol;
+  int n = this->maxcol - this->mincol + 1;
+  for (int i = this->minrow; i <= this->maxrow; i++)  {
+    kernels::Axpy(in[i], this->data[i] + this->mincol, dst, n);
+  }
+}
+
+} // end namespace Gambit
+
 template class Matrix<double>;
 template class Matrix<Rational>;
 template class Matrix<Integer>;
@@ -20,20 +20,51 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <cstdio>
 #include "gambit/nash.h"
 
 namespace Gambit {
 
 namespace Nash {
 
+namespace {
+
+//
+// Append the text of a value to a line being assembled, without
+// going through a string stream
+//
+void AppendValue(std::string &p_line, double p_value, int p_numDecimals)
+{
+  char text[64];
+  int length = snprintf(text, sizeof(text), "%.*f", p_numDecimals, p_value);
+  if (length >= 0 && length < (int) sizeof(text)) {
+    p_line.append(text, length);
+  }
+  else {
+    p_line += lexical_cast<std::string>(p_value, p_numDecimals);
+  }
+}
+
+void AppendValue(std::string &p_line, const Rational &p_value, int)
+{
+  std::string::size_type length = p_line.size();
+  p_line.resize(length + p_value.text_size());
+  char *end = p_value.write_text(&p_line[length]);
+  p_line.resize(end - &p_line[0]);
+}
+
+} // end anonymous namespace
+
 template <class T> void
 MixedStrategyCSVRenderer<T>::Render(const MixedStrategyProfile<T> &p_profile,
 				    const std::string &p_label) const
 {
-  m_stream << p_label;
+  m_buffer = p_label;
   for (int i = 1; i <= p_profile.MixedProfileLength(); i++) {
-    m_stream << "," << lexical_cast<std::string>(p_profile[i], m_numDecimals);
+    m_buffer += ',';
+    AppendValue(m_buffer, p_profile[i], m_numDecimals);
   }
+  m_stream.write(m_buffer.data(), m_buffer.size());
   m_stream << std::endl;
 }
 
@@ -72,10 +103,12 @@ template <class T>
 void BehavStrategyCSVRenderer<T>::Render(const MixedBehaviorProfile<T> &p_profile,
 					 const std::string &p_label) const
 {
-  m_stream << p_label;
+  m_buffer = p_label;
   for (int i = 1; i <= p_profile.Length(); i++) {
-    m_stream << "," << lexical_cast<std::string>(p_profile[i], m_numDecimals);
+    m_buffer += ',';
+    AppendValue(m_buffer, p_profile[i], m_numDecimals);
   }
+  m_stream.write(m_buffer.data(), m_buffer.size());
   m_stream << std::endl;
 }
 
@@ -164,9 +197,24 @@ template class MixedStrategyNullRenderer<Rational>;
 template class MixedStrategyCSVRenderer<double>;
 template class MixedStrategyCSVRenderer<Rational>;
 
+template <class T> void
+RestrictedStrategyRenderer<T>::Render(const MixedStrategyProfile<T> &p_profile,
+				      const std::string &p_label) const
+{
+  if (p_profile.GetGame()->IsRestriction()) {
+    m_renderer->Render(p_profile.Unrestrict(), p_label);
+  }
+  else {
+    m_renderer->Render(p_profile, p_label);
+  }
+}
+
 template class MixedStrategyDetailRenderer<double>;
 template class MixedStrategyDetailRenderer<Rational>;
 
+template class RestrictedStrategyRenderer<double>;
+template class RestrictedStrategyRenderer<Rational>;
+
 template class StrategyProfileRenderer<double>;
 template class StrategyProfileRenderer<Rational>;
 
@@ -457,6 +505,20 @@ SubgameBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   return solutions;
 }
 
+Game UndominatedRestriction(const Game &p_game, int p_numThreads /* = 1 */)
+{
+  StrategySupportProfile support(p_game);
+  while (true) {
+    StrategySupportProfile next = support.MixedUndominated(true, p_numThreads);
+    if (next == support)  break;
+    support = next;
+  }
+  if (support == StrategySupportProfile(p_game)) {
+    return p_game;
+  }
+  return support.Restrict();
+}
+
 template class StrategySolver<double>;
 template class StrategySolver<Rational>;
 
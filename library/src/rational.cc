@@ -38,6 +38,113 @@ namespace Gambit {
 
 static const Integer _Int_One(1);
 
+//
+// Arithmetic on Rationals follows the approach of GMP's mpq functions:
+// common factors are cancelled before, rather than after, multiplying,
+// so that the operands stay small and a full normalization is never needed.
+// When all the numerators and denominators involved are small
+// (see Iissmall()), the computation is carried out on machine words.
+//
+
+namespace {
+
+inline bool AllSmall(const Integer &a, const Integer &b,
+		     const Integer &c, const Integer &d)
+{
+  return a.is_small() && b.is_small() && c.is_small() && d.is_small();
+}
+
+inline int64_t Gcd64(int64_t a, int64_t b)
+{
+  return (int64_t) Igcd64((a < 0) ? -(uint64_t) a : (uint64_t) a,
+			  (b < 0) ? -(uint64_t) b : (uint64_t) b);
+}
+
+// Sets r = a/b + c/d, where b, d > 0 and a/b, c/d are in lowest terms.
+// Requires all of a, b, c, d to be small.
+void AddSmall(int64_t a, int64_t b, int64_t c, int64_t d,
+	      Integer &num, Integer &den)
+{
+  int64_t g = Gcd64(b, d);
+  if (g == 1) {
+    num.set_int64(a * d + c * b);
+    den.set_int64(b * d);
+  }
+  else {
+    int64_t t = a * (d / g) + c * (b / g);
+    int64_t g2 = Gcd64(t, g);
+    num.set_int64(t / g2);
+    den.set_int64((b / g) * (d / g2));
+  }
+}
+
+// Sets r = (a/b) * (c/d), where b, d > 0 and a/b, c/d are in lowest terms.
+// Requires all of a, b, c, d to be small.
+void MulSmall(int64_t a, int64_t b, int64_t c, int64_t d,
+	      Integer &num, Integer &den)
+{
+  if (a == 0 || c == 0) {
+    num.set_int64(0);
+    den.set_int64(1);
+    return;
+  }
+  int64_t g1 = Gcd64(a, d), g2 = Gcd64(c, b);
+  num.set_int64((a / g1) * (c / g2));
+  den.set_int64((b / g2) * (d / g1));
+}
+
+// As AddSmall(), on arbitrary-precision operands.  The order of operations
+// is chosen so that num and den may alias any of the operands.
+void AddLarge(const Integer &x_num, const Integer &x_den,
+	      const Integer &y_num, const Integer &y_den,
+	      Integer &num, Integer &den)
+{
+  Integer g = gcd(x_den, y_den);
+  if (g == 1L) {
+    Integer t;
+    mul(x_num, y_den, t);
+    mul(y_num, x_den, num);
+    add(num, t, num);
+    mul(x_den, y_den, den);
+  }
+  else {
+    Integer xd = x_den / g, yd = y_den / g;
+    Integer t;
+    mul(x_num, yd, t);
+    mul(y_num, xd, num);
+    add(num, t, t);
+    Integer g2 = gcd(t, g);
+    if (g2 == 1L) {
+      num = t;
+      mul(xd, y_den, den);
+    }
+    else {
+      div(t, g2, num);
+      div(y_den, g2, t);
+      mul(xd, t, den);
+    }
+  }
+}
+
+// As MulSmall(), on arbitrary-precision operands.
+void MulLarge(const Integer &x_num, const Integer &x_den,
+	      const Integer &y_num, const Integer &y_den,
+	      Integer &num, Integer &den)
+{
+  if (sign(x_num) == 0 || sign(y_num) == 0) {
+    num.set_int64(0);
+    den.set_int64(1);
+    return;
+  }
+  Integer g1 = gcd(x_num, y_den), g2 = gcd(y_num, x_den);
+  Integer a = x_num / g1, c = y_num / g2;
+  Integer b = x_den / g2, d = y_den / g1;
+  mul(a, c, num);
+  mul(b, d, den);
+}
+
+}  // end anonymous namespace
+
 void Rational::normalize(void)
 {
   int s = sign(den);
@@ -49,6 +156,16 @@ void Rational::normalize(void)
     num.negate();
   }
 
+  if (num.is_small() && den.is_small()) {
+    int64_t n = num.as_int64(), d = den.as_int64();
+    int64_t g = Gcd64(n, d);
+    if (g != 1) {
+      num.set_int64(n / g);
+      den.set_int64(d / g);
+    }
+    return;
+  }
+
   Integer g = gcd(num, den);
   if (ucompare(g, _Int_One) != 0)  {
     num /= g;
@@ -58,71 +175,62 @@ void Rational::normalize(void)
 
 void      add(const Rational& x, const Rational& y, Rational& r)
 {
-  if (&r != &x && &r != &y)
-    {
-      mul(x.num, y.den, r.num);
-      mul(x.den, y.num, r.den);
-      add(r.num, r.den, r.num);
-      mul(x.den, y.den, r.den);
-    }
-  else
-    {
-      Integer tmp;
-      mul(x.den, y.num, tmp);
-      mul(x.num, y.den, r.num);
-      add(r.num, tmp, r.num);
-      mul(x.den, y.den, r.den);
-    }
-  r.normalize();
+  if (AllSmall(x.num, x.den, y.num, y.den)) {
+    AddSmall(x.num.as_int64(), x.den.as_int64(),
+	     y.num.as_int64(), y.den.as_int64(), r.num, r.den);
+  }
+  else {
+    AddLarge(x.num, x.den, y.num, y.den, r.num, r.den);
+  }
 }
 
 void      sub(const Rational& x, const Rational& y, Rational& r)
 {
-  if (&r != &x && &r != &y)
-    {
-      mul(x.num, y.den, r.num);
-      mul(x.den, y.num, r.den);
-      sub(r.num, r.den, r.num);
-      mul(x.den, y.den, r.den);
-    }
-  else
-    {
-      Integer tmp;
-      mul(x.den, y.num, tmp);
-      mul(x.num, y.den, r.num);
-      sub(r.num, tmp, r.num);
-      mul(x.den, y.den, r.den);
-    }
-  r.normalize();
+  if (AllSmall(x.num, x.den, y.num, y.den)) {
+    AddSmall(x.num.as_int64(), x.den.as_int64(),
+	     -y.num.as_int64(), y.den.as_int64(), r.num, r.den);
+  }
+  else {
+    AddLarge(x.num, x.den, -y.num, y.den, r.num, r.den);
+  }
 }
 
 void      mul(const Rational& x, const Rational& y, Rational& r)
 {
-  mul(x.num, y.num, r.num);
-  mul(x.den, y.den, r.den);
-  r.normalize();
+  if (AllSmall(x.num, x.den, y.num, y.den)) {
+    MulSmall(x.num.as_int64(), x.den.as_int64(),
+	     y.num.as_int64(), y.den.as_int64(), r.num, r.den);
+  }
+  else {
+    MulLarge(x.num, x.den, y.num, y.den, r.num, r.den);
+  }
 }
 
 void      div(const Rational& x, const Rational& y, Rational& r)
 {
-  if (&r != &x && &r != &y)
-    {
-      mul(x.num, y.den, r.num);
-      mul(x.den, y.num, r.den);
+  if (AllSmall(x.num, x.den, y.num, y.den)) {
+    int64_t c = y.num.as_int64(), d = y.den.as_int64();
+    if (c == 0) {
+      throw ZeroDivideException();
     }
-  else
-    {
-      Integer tmp;
-      mul(x.num, y.den, tmp);
-      mul(y.num, x.den, r.den);
-      r.num = tmp;
+    else if (c < 0) {
+      c = -c;
+      d = -d;
     }
-  r.normalize();
+    MulSmall(x.num.as_int64(), x.den.as_int64(), d, c, r.num, r.den);
+  }
+  else if (sign(y.num) > 0) {
+    MulLarge(x.num, x.den, y.den, y.num, r.num, r.den);
+  }
+  else if (sign(y.num) < 0) {
+    MulLarge(x.num, x.den, -y.den, -y.num, r.num, r.den);
+  }
+  else {
+    throw ZeroDivideException();
+  }
 }
 
 
-
-
 void Rational::invert(void)
 {
   Integer tmp = num;  
@@ -143,7 +251,16 @@ int compare(const Rational& x, const Rational& y)
   int xsgn = sign(x.num);
   int ysgn = sign(y.num);
   int d = xsgn - ysgn;
-  if (d == 0 && xsgn != 0) d = compare(x.num * y.den, x.den * y.num);
+  if (d == 0 && xsgn != 0) {
+    if (AllSmall(x.num, x.den, y.num, y.den)) {
+      int64_t lhs = x.num.as_int64() * y.den.as_int64();
+      int64_t rhs = x.den.as_int64() * y.num.as_int64();
+      d = (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+    }
+    else {
+      d = compare(x.num * y.den, x.den * y.num);
+    }
+  }
   return d;
 }
 
@@ -212,10 +329,10 @@ Rational abs(const Rational& x)
 
 Rational sqr(const Rational& x)
 {
+  // x is in lowest terms, so its square is as well
   Rational r;
   mul(x.num, x.num, r.num);
   mul(x.den, x.den, r.den);
-  r.normalize();
   return r;
 }
 
@@ -275,17 +392,31 @@ Rational pow(const Rational& x, long y)
   return r;
 }
 
+int Rational::text_size() const
+{
+  return num.text_size() + den.text_size();
+}
+
+char *Rational::write_text(char *p_buffer) const
+{
+  p_buffer = num.write_text(p_buffer);
+  if (den != 1L) {
+    *p_buffer++ = '/';
+    p_buffer = den.write_text(p_buffer);
+  }
+  return p_buffer;
+}
+
 std::ostream &operator << (std::ostream &s, const Rational& y)
 {
-  if (y.denominator() == 1L)
-    s << y.numerator();
-  else
-    {
-      s << y.numerator();
-      s << "/";
-      s << y.denominator();
-    }
-  return s;
+  char text[128];
+  if (y.text_size() <= (int) sizeof(text)) {
+    char *end = y.write_text(text);
+    return s.write(text, end - text);
+  }
+  std::string buffer(y.text_size(), '\0');
+  char *end = y.write_text(&buffer[0]);
+  return s.write(buffer.data(), end - &buffer[0]);
 }
 
 std::istream &operator>>(std::istream &f, Rational &y)
@@ -506,6 +637,9 @@ const Integer& Rational::denominator() const { return den; }
 
 Rational::operator double(void) const 
 {
+  if (num.is_small() && den.is_small()) {
+    return (double) num.as_int64() / (double) den.as_int64();
+  }
   // We approach this in terms of absolute values because there is
   // (apparently) a bug in ratio() which yields incorrect results
   // for some negative numbers (TLT, 27 Feb 2006).
@@ -537,107 +671,134 @@ Rational Rational::operator/(const Rational &y) const
 }
 
 
+namespace {
+
+const uint64_t PowersOfTen[] = {
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+  10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+  100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL
+};
+
+/// Appends p_count digits, with value p_chunk, to p_value
+void AppendDigits(Integer &p_value, uint64_t p_chunk, int p_count)
+{
+  if (p_count == 0) return;
+  Integer chunk;
+  chunk.set_int64((int64_t) p_chunk);
+  if (sign(p_value) == 0) {
+    p_value = chunk;
+    return;
+  }
+  Integer scale;
+  scale.set_int64((int64_t) PowersOfTen[p_count]);
+  p_value *= scale;
+  p_value += chunk;
+}
+
+/// Reads a run of decimal digits, appending them to p_value.
+/// Digits are accumulated in a machine word and folded into p_value
+/// eighteen at a time.  Returns the number of digits read.
+long ReadDigits(const char *&p_text, Integer &p_value)
+{
+  long total = 0;
+  uint64_t chunk = 0;
+  int count = 0;
+  while (*p_text >= '0' && *p_text <= '9') {
+    chunk = chunk * 10 + (*p_text++ - '0');
+    if (++count == 18) {
+      AppendDigits(p_value, chunk, count);
+      chunk = 0;
+      total += count;
+      count = 0;
+    }
+  }
+  AppendDigits(p_value, chunk, count);
+  return total + count;
+}
+
+/// Reads an optionally-negative decimal exponent
+long ReadExponent(const char *&p_text)
+{
+  long expsign = 1, exponent = 0;
+  if (*p_text == '-') {
+    expsign = -1;
+    p_text++;
+  }
+  while (*p_text >= '0' && *p_text <= '9') {
+    exponent = exponent * 10 + (*p_text++ - '0');
+  }
+  return expsign * exponent;
+}
+
+} // end anonymous namespace
+
 template<>
 Rational lexical_cast(const std::string &f)
 {
-  char ch = ' ';
+  const char *p = f.c_str();
   int sign = 1;
-  unsigned int index = 0, length = f.length();
+  long exponent = 0;
   Integer num = 0, denom = 1;
 
-  while (isspace(ch) && index<=length) {
-    ch = f[index++];
-  }
+  while (isspace((unsigned char) *p)) p++;
 
-  if (ch == '-' && index<=length)  {
+  if (*p == '-')  {
     sign = -1;
-    ch=f[index++];
+    p++;
   }
 
-  while (ch >= '0' && ch <= '9' && index<=length)   {
-    num *= 10;
-    num += (int) (ch - '0');
-    ch=f[index++];
-  }
+  ReadDigits(p, num);
 
-  if (ch == '/')  {
+  if (*p == '/')  {
     denom = 0;
-    ch=f[index++];
-    while (ch >= '0' && ch <= '9' && index<=length)  {
-      denom *= 10;
-      denom += (int) (ch - '0');
-      ch=f[index++];
-    }
+    p++;
+    ReadDigits(p, denom);
   }
-  else if (ch == '.')  {
-    denom = 1;
-    ch=f[index++];
-    while (ch >= '0' && ch <= '9' && index<=length)  {
-      denom *= 10;
-      num *= 10;
-      num += (int) (ch - '0');
-      ch=f[index++];
-    }
-    
-    if (ch == 'e' || ch == 'E') {
-      int expsign = 1;
-      Integer exponent = 0;
-      ch = f[index++];
-      if (ch == '-')  {
-	expsign = -1;
-	ch = f[index++];
-      }
-      while (ch >= '0' && ch <= '9' && index <= length) {
-	exponent *= 10;
-	exponent += (int) (ch - '0');
-	ch = f[index++];
-      }
-      if (exponent * expsign > 0) {
-	while (exponent > 0) {
-	  num *= 10;
-	  exponent -= 1;
-	}
-      }
-      else if (exponent * expsign < 0) {
-	while (exponent > 0) {
-	  denom *= 10;
-	  exponent -= 1;
-	}
-      }
+  else if (*p == '.')  {
+    p++;
+    exponent = -ReadDigits(p, num);
+    if (*p == 'e' || *p == 'E') {
+      p++;
+      exponent += ReadExponent(p);
     }
   }
-  else if (ch == 'e' || ch == 'E') {
-    int expsign = 1;
-    Integer exponent = 0;
-    ch = f[index++];
-    if (ch == '-')  {
-      expsign = -1;
-      ch = f[index++];
-    }
-    while (ch >= '0' && ch <= '9' && index <= length) {
-      exponent *= 10;
-      exponent += (int) (ch - '0');
-      ch = f[index++];
-    }
-    if (exponent * expsign > 0) {
-      while (exponent > 0) {
-	num *= 10;
-	exponent -= 1;
-      }
-    }
-    else if (exponent * expsign < 0) {
-      while (exponent > 0) {
-	denom *= 10;
-	exponent -= 1;
-      }
-    }
+  else if (*p == 'e' || *p == 'E') {
+    p++;
+    exponent = ReadExponent(p);
   }
 
-  if (ch != '\0') {
+  if (*p != '\0') {
     throw ValueException();
   }
 
-  return Rational(num * sign, denom);
+  if (exponent > 0) {
+    num *= pow(Integer(10), exponent);
+  }
+  else if (exponent < 0) {
+    denom *= pow(Integer(10), -exponent);
+  }
+  if (sign < 0) {
+    num.negate();
+  }
+  return Rational(num, denom);
+}
+
+template<>
+std::string lexical_cast(const Rational &p_value)
+{
+  std::string buffer(p_value.text_size(), '\0');
+  buffer.resize(p_value.write_text(&buffer[0]) - &buffer[0]);
+  return buffer;
+}
+
+// The precision applies only to fixed-point output of floating-point
+// values; rationals are always written exactly.
+template<>
+std::string lexical_cast(const Rational &p_value, int)
+{
+  return lexical_cast<std::string>(p_value);
 }
 
 }  // end namespace Gambit
@@ -123,4 +123,112 @@ void StrategyProfileIterator::operator++(void)
   }
 }
 
+//===========================================================================
+//                        class ContingencyIterator
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//                               Lifecycle
+//---------------------------------------------------------------------------
+
+ContingencyIterator::ContingencyIterator(const Offsets &p_offsets)
+  : m_offsets(p_offsets), m_strategy(p_offsets.Length()),
+    m_end(NumContingencies(p_offsets) + 1)
+{
+  Seek(1);
+}
+
+ContingencyIterator::ContingencyIterator(const Offsets &p_offsets,
+					 long p_begin, long p_end)
+  : m_offsets(p_offsets), m_strategy(p_offsets.Length()), m_end(p_end)
+{
+  Seek(p_begin);
+}
+
+void ContingencyIterator::Seek(long p_position)
+{
+  m_position = p_position;
+  m_index = 1;
+  if (m_position >= m_end)  return;
+  long rest = p_position - 1;
+  for (int pl = 1; pl <= m_offsets.Length(); pl++) {
+    m_strategy[pl] = rest % m_offsets[pl].Length() + 1;
+    rest /= m_offsets[pl].Length();
+    m_index += m_offsets[pl][m_strategy[pl]];
+  }
+}
+
+//---------------------------------------------------------------------------
+//                                Offsets
+//---------------------------------------------------------------------------
+
+ContingencyIterator::Offsets
+ContingencyIterator::TableOffsets(const Array<int> &p_dim)
+{
+  Offsets offsets(p_dim.Length());
+  long stride = 1;
+  for (int pl = 1; pl <= p_dim.Length(); pl++) {
+    offsets[pl] = Array<long>(p_dim[pl]);
+    for (int st = 1; st <= p_dim[pl]; st++) {
+      offsets[pl][st] = (st - 1) * stride;
+    }
+    stride *= p_dim[pl];
+  }
+  return offsets;
+}
+
+ContingencyIterator::Offsets
+ContingencyIterator::SupportOffsets(const StrategySupportProfile &p_support)
+{
+  return SupportOffsets(p_support, 0);
+}
+
+ContingencyIterator::Offsets
+ContingencyIterator::SupportOffsets(const StrategySupportProfile &p_support,
+				    int p_player)
+{
+  int numPlayers = p_support.GetGame()->NumPlayers();
+  Offsets offsets(numPlayers);
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    if (pl == p_player) {
+      offsets[pl] = Array<long>(1);
+      offsets[pl][1] = 0;
+      continue;
+    }
+    offsets[pl] = Array<long>(p_support.NumStrategies(pl));
+    for (int st = 1; st <= p_support.NumStrategies(pl); st++) {
+      offsets[pl][st] = p_support.GetStrategy(pl, st)->m_offset;
+    }
+  }
+  return offsets;
+}
+
+long ContingencyIterator::NumContingencies(const Offsets &p_offsets)
+{
+  long size = 1;
+  for (int pl = 1; pl <= p_offsets.Length(); pl++) {
+    size *= p_offsets[pl].Length();
+  }
+  return size;
+}
+
+//---------------------------------------------------------------------------
+//                                Iteration
+//---------------------------------------------------------------------------
+
+void ContingencyIterator::operator++(void)
+{
+  if (++m_position >= m_end)  return;
+  for (int pl = 1; pl <= m_offsets.Length(); pl++) {
+    const Array<long> &offsets = m_offsets[pl];
+    if (m_strategy[pl] < offsets.Length()) {
+      m_index += offsets[m_strategy[pl] + 1] - offsets[m_strategy[pl]];
+      m_strategy[pl]++;
+      return;
+    }
+    m_index += offsets[1] - offsets[m_strategy[pl]];
+    m_strategy[pl] = 1;
+  }
+}
+
 } // end namespace Gambit
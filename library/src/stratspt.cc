@@ -20,8 +20,13 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <cmath>
+#include <algorithm>
+
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
+#include "gambit/linalg/lpsolve.h"
+#include "gambit/linalg/sparselp.h"
 
 namespace Gambit {
 
@@ -226,7 +231,27 @@ bool StrategySupportProfile::Dominates(const GameStrategy &s,
 				bool p_strict) const
 {
   bool equal = true;
-  
+
+  GameTableRep *table = dynamic_cast<GameTableRep *>(static_cast<GameRep *>(m_nfg));
+  if (table) {
+    // Compare payoffs along each line of the table on which only the
+    // player's strategy varies, reading the table directly
+    int pl = s->GetPlayer()->GetNumber();
+    for (ContingencyIterator iter(ContingencyIterator::SupportOffsets(*this, pl));
+	 !iter.AtEnd(); iter++) {
+      Rational ap = table->GetPayoff<Rational>(iter.GetIndex() + s->m_offset, pl);
+      Rational bp = table->GetPayoff<Rational>(iter.GetIndex() + t->m_offset, pl);
+      if (p_strict && ap <= bp) {
+	return false;
+      }
+      else if (!p_strict) {
+	if (ap < bp) return false;
+	else if (ap > bp) equal = false;
+      }
+    }
+    return (p_strict || !equal);
+  }
+
   for (StrategyProfileIterator iter(*this); !iter.AtEnd(); iter++) {
     Rational ap = (*iter)->GetStrategyValue(s);
     Rational bp = (*iter)->GetStrategyValue(t);
@@ -361,6 +386,287 @@ StrategySupportProfile::Undominated(bool p_strict, const Array<int> &players) co
   return newS;
 }
 
+//---------------------------------------------------------------------------
+//        Identification of strategies dominated by mixed strategies
+//---------------------------------------------------------------------------
+
+namespace {
+
+typedef std::vector<std::vector<Rational> > PlayerPayoffs;
+
+//
+// Collects the payoffs to the player of each of its strategies in the
+// support (indexed from 1), against each contingency of the other
+// players' strategies in the support.  The contingencies are listed in
+// the same order for every strategy.
+//
+void GetPlayerPayoffs(const StrategySupportProfile &p_support, int p_player,
+		      PlayerPayoffs &p_payoffs)
+{
+  int numStrats = p_support.NumStrategies(p_player);
+  p_payoffs.assign(numStrats + 1, std::vector<Rational>());
+
+  Game game = p_support.GetGame();
+  GameTableRep *table = dynamic_cast<GameTableRep *>(static_cast<GameRep *>(game));
+  if (table) {
+    ContingencyIterator::Offsets offsets = 
+      ContingencyIterator::SupportOffsets(p_support);
+    for (ContingencyIterator iter(ContingencyIterator::SupportOffsets(p_support, p_player));
+	 !iter.AtEnd(); iter++) {
+      for (int st = 1; st <= numStrats; st++) {
+	p_payoffs[st].push_back(table->GetPayoff<Rational>(iter.GetIndex() + offsets[p_player][st], p_player));
+      }
+    }
+    return;
+  }
+
+  for (int st = 1; st <= numStrats; st++) {
+    for (StrategyProfileIterator iter(p_support, p_player, st);
+	 !iter.AtEnd(); iter++) {
+      p_payoffs[st].push_back((*iter)->GetPayoff(p_player));
+    }
+  }
+}
+
+//
+// Decides whether strategy s is dominated by a mixture x of the other
+// strategies t, by solving in exact arithmetic
+//   maximize e subject to sum_t x_t u(t,c) - e >= u(s,c) for each c,
+//                         sum_t x_t = 1, x >= 0,
+// with e free, which is written as the difference of two columns.
+// The strategy is strictly dominated if e > 0.  If e = 0, it is weakly
+// dominated if, among the mixtures which do at least as well against
+// every contingency, some does better in total.
+//
+bool IsDominatedExact(const PlayerPayoffs &p_payoffs, int p_strategy,
+		      bool p_strict)
+{
+  int numStrats = p_payoffs.size() - 1;
+  int numConts = p_payoffs[p_strategy].size();
+  int others = numStrats - 1;
+
+  Matrix<Rational> A(1, numConts + 1, 1, others + 2);
+  Vector<Rational> b(1, numConts + 1), c(1, others + 2);
+  A = Rational(0);
+  c = Rational(0);
+  for (int i = 1; i <= numConts; i++) {
+    for (int t = 1, col = 1; t <= numStrats; t++) {
+      if (t != p_strategy) {
+	A(i, col++) = -p_payoffs[t][i-1];
+      }
+    }
+    A(i, others + 1) = Rational(1);
+    A(i, others + 2) = Rational(-1);
+    b[i] = -p_payoffs[p_strategy][i-1];
+  }
+  for (int col = 1; col <= others; col++) {
+    A(numConts + 1, col) = Rational(1);
+  }
+  b[numConts + 1] = Rational(1);
+  c[others + 1] = Rational(1);
+  c[others + 2] = Rational(-1);
+
+  Rational excess;
+  {
+    linalg::LPSolve<Rational> lp(A, b, c, 1);
+    excess = lp.OptimumCost();
+  }
+  if (excess > Rational(0))  return true;
+  if (p_strict || excess < Rational(0))  return false;
+
+  Matrix<Rational> W(1, numConts + 1, 1, others);
+  Vector<Rational> total(1, others);
+  Rational own(0);
+  for (int i = 1; i <= numConts + 1; i++) {
+    for (int col = 1; col <= others; col++) {
+      W(i, col) = A(i, col);
+    }
+  }
+  for (int col = 1; col <= others; col++) {
+    total[col] = Rational(0);
+    for (int i = 1; i <= numConts; i++) {
+      total[col] -= A(i, col);
+    }
+  }
+  for (int i = 0; i < numConts; i++) {
+    own += p_payoffs[p_strategy][i];
+  }
+  linalg::LPSolve<Rational> lp(W, b, total, 1);
+  return (lp.IsFeasible() && lp.OptimumCost() > own);
+}
+
+//
+// Screens a player's strategies in floating point, by the dual of the
+// program in IsDominatedExact().  By the minimax theorem, the most by
+// which a mixture of the other strategies can exceed strategy s against
+// every contingency is
+//   e = min over beliefs y of (max_t u(t).y - u(s).y),
+// where y is a distribution over the contingencies.  With the payoffs
+// shifted and scaled to lie in [-1,0], so that w = -max_t u(t).y is in
+// [0,1], this is the negative of the optimum of
+//   maximize u(s).y + w subject to u(t).y + w <= 0 for t != s,
+//                                  sum_c y_c = 1, y, w >= 0.
+// There is a row for every strategy, and that of s is relaxed by raising
+// its right-hand side out of reach, so the constraint matrix is shared
+// by all the tests and is built only once.  Each program is solved from
+// the slack basis: consecutive programs have unrelated objectives, and
+// resolving from the last optimum takes several times as many pivots.
+//
+class DominanceScreen {
+public:
+  DominanceScreen(const PlayerPayoffs &p_payoffs);
+
+  /// Returns true if the strategy is certainly not dominated
+  bool RulesOut(int p_strategy) const;
+
+private:
+  int m_numStrats, m_numConts;
+  std::vector<std::vector<double> > m_payoffs;
+  std::vector<linalg::SparseColumn> m_columns;
+
+  static const double s_relaxed, s_tolerance;
+
+  DominanceScreen(const DominanceScreen &);
+  DominanceScreen &operator=(const DominanceScreen &);
+};
+
+const double DominanceScreen::s_relaxed = 2.0;
+const double DominanceScreen::s_tolerance = 1.0e-7;
+
+DominanceScreen::DominanceScreen(const PlayerPayoffs &p_payoffs)
+  : m_numStrats(p_payoffs.size() - 1), m_numConts(p_payoffs[1].size()),
+    m_payoffs(m_numStrats + 1), m_columns(m_numConts + 2)
+{
+  double maxPay = (double) p_payoffs[1][0], minPay = maxPay;
+  for (int st = 1; st <= m_numStrats; st++) {
+    m_payoffs[st].resize(m_numConts);
+    for (int i = 0; i < m_numConts; i++) {
+      m_payoffs[st][i] = (double) p_payoffs[st][i];
+      maxPay = std::max(maxPay, m_payoffs[st][i]);
+      minPay = std::min(minPay, m_payoffs[st][i]);
+    }
+  }
+  double scale = (maxPay > minPay) ? maxPay - minPay : 1.0;
+
+  for (int i = 0; i < m_numConts; i++) {
+    for (int st = 1; st <= m_numStrats; st++) {
+      m_payoffs[st][i] = (m_payoffs[st][i] - maxPay) / scale;
+      if (m_payoffs[st][i] != 0.0) {
+	m_columns[i + 1].push_back(std::make_pair(st, m_payoffs[st][i]));
+      }
+    }
+    m_columns[i + 1].push_back(std::make_pair(m_numStrats + 1, 1.0));
+  }
+  for (int st = 1; st <= m_numStrats; st++) {
+    m_columns[m_numConts + 1].push_back(std::make_pair(st, 1.0));
+  }
+}
+
+bool DominanceScreen::RulesOut(int p_strategy) const
+{
+  Vector<double> b(m_numStrats + 1), c(m_numConts + 1);
+  b = 0.0;
+  b[p_strategy] = s_relaxed;
+  b[m_numStrats + 1] = 1.0;
+  for (int i = 1; i <= m_numConts; i++) {
+    c[i] = m_payoffs[p_strategy][i-1];
+  }
+  c[m_numConts + 1] = 1.0;
+
+  try {
+    linalg::SparseLPSolve lp(m_columns, b, c, 1);
+    return (lp.IsFeasible() && lp.IsBounded() &&
+	    lp.OptimumCost() > s_tolerance);
+  }
+  catch (linalg::SparseInverse::SingularBasis &) {
+    // Leave the decision to the exact test
+    return false;
+  }
+}
+
+} // end anonymous namespace
+
+bool StrategySupportProfile::IsMixedDominated(const GameStrategy &s,
+					      bool p_strict) const
+{
+  int pl = s->GetPlayer()->GetNumber();
+  int st = GetIndex(s);
+  if (st == 0 || NumStrategies(pl) < 2) {
+    return false;
+  }
+  IntegerArena arena;
+  PlayerPayoffs payoffs;
+  GetPlayerPayoffs(*this, pl, payoffs);
+  return IsDominatedExact(payoffs, st, p_strict);
+}
+
+//
+// The screening programs of a player share one constraint matrix, and
+// are solved on as many threads as requested.  Strategies are tested
+// against the current support and removed together at the end, as in
+// Undominated().
+//
+StrategySupportProfile 
+StrategySupportProfile::MixedUndominated(bool p_strict,
+					 const Array<int> &p_players,
+					 int p_numThreads) const
+{
+  StrategySupportProfile newS(*this);
+
+  for (int i = 1; i <= p_players.Length(); i++) {
+    int pl = p_players[i];
+    int numStrats = NumStrategies(pl);
+    if (numStrats < 2)  continue;
+
+    IntegerArena arena;
+    PlayerPayoffs payoffs;
+    GetPlayerPayoffs(*this, pl, payoffs);
+
+    std::vector<char> dominated(numStrats + 1, 0);
+    DominanceScreen screen(payoffs);
+    std::string error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(std::max(1, p_numThreads))
+#endif  // _OPENMP
+    for (int st = 1; st <= numStrats; st++) {
+      try {
+	if (!screen.RulesOut(st)) {
+	  IntegerArena threadArena;
+	  dominated[st] = IsDominatedExact(payoffs, st, p_strict);
+	}
+      }
+      catch (std::exception &e) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_dominance_error)
+#endif  // _OPENMP
+	error = e.what();
+      }
+    }
+    if (!error.empty()) {
+      throw Exception(error);
+    }
+
+    for (int st = 1; st <= numStrats; st++) {
+      if (dominated[st]) {
+	newS.RemoveStrategy(GetStrategy(pl, st));
+      }
+    }
+  }
+
+  return newS;
+}
+
+StrategySupportProfile 
+StrategySupportProfile::MixedUndominated(bool p_strict,
+					 int p_numThreads) const
+{
+  Array<int> players;
+  for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
+    players.Append(pl);
+  }
+  return MixedUndominated(p_strict, players, p_numThreads);
+}
+
 //---------------------------------------------------------------------------
 //                Identification of overwhelmed strategies
 //---------------------------------------------------------------------------
@@ -401,7 +707,7 @@ Game StrategySupportProfile::Restrict(void) const
     player->m_unrestricted = m_nfg->Players()[pl];
     for (int st = 1; st <= player->NumStrategies(); st++) {
       GameStrategyRep *strategy = player->m_strategies[st];
-      strategy->m_unrestricted = m_nfg->Players()[pl]->Strategies()[st];
+      strategy->m_unrestricted = m_support[pl][st];
     }
   }
   dynamic_cast<GameTableRep &>(*restricted).m_unrestricted = m_nfg;
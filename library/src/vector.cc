@@ -22,6 +22,39 @@
 
 #include "gambit/gambit.h"
 #include "gambit/vector.imp"
+#include "gambit/kernels.h"
+
+namespace Gambit {
+
+template<> Vector<double>& Vector<double>::operator+=(const Vector<double>& V)
+{
+  if (!Check(V))   throw DimensionException();
+
+  kernels::Axpy(1.0, V.data + mindex, data + mindex, maxdex - mindex + 1);
+  return *this;
+}
+
+template<> Vector<double>& Vector<double>::operator-=(const Vector<double>& V)
+{
+  if (!Check(V))   throw DimensionException();
+
+  kernels::Axpy(-1.0, V.data + mindex, data + mindex, maxdex - mindex + 1);
+  return *this;
+}
+
+template<> double Vector<double>::operator*(const Vector<double>& V) const
+{
+  if (!Check(V))   throw DimensionException();
+
+  return kernels::Dot(data + mindex, V.data + mindex, maxdex - mindex + 1);
+}
+
+template<> double Vector<double>::NormSquared() const
+{
+  return kernels::Dot(data + mindex, data + mindex, maxdex - mindex + 1);
+}
+
+} // end namespace Gambit
 
 template class Gambit::Vector<int>;
 template class Gambit::Vector<long>;
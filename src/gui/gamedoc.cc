@@ -21,6 +21,7 @@
 //
 
 #include <sstream>
+#include <algorithm>
 #include <fstream>
 
 #include <wx/wxprec.h>
@@ -28,6 +29,7 @@
 #include <wx/wx.h>
 #endif  // WX_PRECOMP
 #include <wx/filename.h>       // used to create temp files for undo/redo
+#include <wx/thread.h>         // for wxThread::GetCPUCount()
 
 #include "gambit/gambit.h"
 #include "gambit/tinyxml.h"    // for XML parser for LoadDocument()
@@ -116,7 +118,7 @@ bool gbtBehavDominanceStack::PreviousLevel(void)
 
 gbtStrategyDominanceStack::gbtStrategyDominanceStack(gbtGameDocument *p_doc,
 						     bool p_strict)
-  : m_doc(p_doc), m_strict(p_strict), m_noFurther(false)
+  : m_doc(p_doc), m_strict(p_strict), m_mixed(false), m_noFurther(false)
 {
   Reset();
 }
@@ -132,6 +134,12 @@ void gbtStrategyDominanceStack::SetStrict(bool p_strict)
   m_strict = p_strict;
 }
 
+void gbtStrategyDominanceStack::SetMixed(bool p_mixed)
+{
+  if (m_mixed != p_mixed)  Reset();
+  m_mixed = p_mixed;
+}
+
 void gbtStrategyDominanceStack::Reset(void)
 {
   for (int i = 1; i <= m_supports.Length(); delete m_supports[i++]);
@@ -157,7 +165,11 @@ bool gbtStrategyDominanceStack::NextLevel(void)
     players.Append(pl);
   }
 
-  Gambit::StrategySupportProfile newSupport = 
+  // The linear programs for mixed dominance are solved on as many
+  // threads as there are processors
+  Gambit::StrategySupportProfile newSupport = (m_mixed) ?
+    m_supports[m_current]->MixedUndominated(m_strict, players,
+					    std::max(1, wxThread::GetCPUCount())) :
     m_supports[m_current]->Undominated(m_strict, players);
 
   if (newSupport != *m_supports[m_current]) {
@@ -561,6 +573,17 @@ bool gbtGameDocument::GetStrategyElimStrength(void) const
   return m_stratSupports.GetStrict();
 }
 
+void gbtGameDocument::SetStrategyElimMixed(bool p_mixed)
+{
+  m_stratSupports.SetMixed(p_mixed);
+  UpdateViews(GBT_DOC_MODIFIED_VIEWS);
+}
+
+bool gbtGameDocument::GetStrategyElimMixed(void) const
+{
+  return m_stratSupports.GetMixed();
+}
+
 bool gbtGameDocument::NextStrategyElimLevel(void)
 {
   bool ret = m_stratSupports.NextLevel();
@@ -113,7 +113,7 @@ public:
 class gbtStrategyDominanceStack {
 private:
   gbtGameDocument *m_doc;
-  bool m_strict;
+  bool m_strict, m_mixed;
   Gambit::Array<Gambit::StrategySupportProfile *> m_supports;
   int m_current;
   bool m_noFurther;
@@ -154,6 +154,18 @@ public:
   //!
   bool GetStrict(void) const { return m_strict; }
 
+  //!
+  //! Sets whether strategies are eliminated if dominated by mixed
+  //! strategies, or only if dominated by pure strategies.  If this
+  //! changes the internal setting, a Reset() is done
+  //!
+  void SetMixed(bool p_mixed);
+
+  //!
+  //! Gets whether strategies are eliminated if dominated by mixed strategies
+  //!
+  bool GetMixed(void) const { return m_mixed; }
+
   //!
   //! Reset the stack by clearing out all supports
   //!
@@ -331,6 +343,8 @@ public:
     { return m_stratSupports.GetCurrent(); }
   void SetStrategyElimStrength(bool p_strict);
   bool GetStrategyElimStrength(void) const;
+  void SetStrategyElimMixed(bool p_mixed);
+  bool GetStrategyElimMixed(void) const;
   bool NextStrategyElimLevel(void);
   void PreviousStrategyElimLevel(void);
   void TopStrategyElimLevel(void);
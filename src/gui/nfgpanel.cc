@@ -336,6 +336,7 @@ private:
 
   // Event handlers
   void OnStrength(wxCommandEvent &);
+  void OnDominators(wxCommandEvent &);
   void OnTopLevel(wxCommandEvent &);
   void OnPreviousLevel(wxCommandEvent &);
   void OnNextLevel(wxCommandEvent &);
@@ -370,9 +371,17 @@ gbtStrategyDominanceToolbar::gbtStrategyDominanceToolbar(wxWindow *p_parent,
 	  wxCommandEventHandler(gbtStrategyDominanceToolbar::OnStrength));
   topSizer->Add(choice, 0, wxALL | wxALIGN_CENTER, 5);
 
-  topSizer->Add(new wxStaticText(this, wxID_STATIC, wxT("dominated:")),
+  topSizer->Add(new wxStaticText(this, wxID_STATIC, wxT("dominated by")),
 		0, wxALL | wxALIGN_CENTER, 5);
 
+  wxString byChoices[] = { wxT("pure strategies"), wxT("mixed strategies") };
+  wxChoice *byChoice = new wxChoice(this, -1, wxDefaultPosition, wxDefaultSize,
+				    2, byChoices);
+  byChoice->SetSelection(0);
+  Connect(byChoice->GetId(), wxEVT_COMMAND_CHOICE_SELECTED,
+	  wxCommandEventHandler(gbtStrategyDominanceToolbar::OnDominators));
+  topSizer->Add(byChoice, 0, wxALL | wxALIGN_CENTER, 5);
+
   m_topButton = new wxBitmapButton(this, -1, wxBitmap(tobegin_xpm));
   m_topButton->SetToolTip(_("Show all strategies"));
   Connect(m_topButton->GetId(), wxEVT_COMMAND_BUTTON_CLICKED,
@@ -412,6 +421,11 @@ void gbtStrategyDominanceToolbar::OnStrength(wxCommandEvent &p_event)
   m_doc->SetStrategyElimStrength(p_event.GetSelection() == 0);
 }
 
+void gbtStrategyDominanceToolbar::OnDominators(wxCommandEvent &p_event)
+{
+  m_doc->SetStrategyElimMixed(p_event.GetSelection() == 1);
+}
+
 void gbtStrategyDominanceToolbar::OnTopLevel(wxCommandEvent &)
 {
   m_doc->TopStrategyElimLevel();
@@ -20,11 +20,23 @@
 # Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #
 import itertools
+import numbers
 
 from libcpp cimport bool
 from gambit.lib.error import UndefinedOperationError
 import gambit.gte
 
+cdef c_Rational _payoff_to_rational(value) except *:
+    # Accepts the same payoffs as Outcome.__setitem__, as well as integer
+    # types such as those of numpy
+    if isinstance(value, numbers.Integral):
+        value = int(value)
+    elif not (isinstance(value, decimal.Decimal) or
+              isinstance(value, fractions.Fraction)):
+        raise TypeError("payoff argument should be a numeric type instance")
+    text = str(value).encode('ascii')
+    return to_rational(text)
+
 cdef class Outcomes(Collection):
     "Represents a collection of outcomes in a game."
     cdef c_Game game
@@ -146,13 +158,38 @@ cdef class Game(object):
         cdef Game g
         if len(set(a.shape for a in arrays)) > 1:
             raise ValueError("All specified arrays must have the same shape")
+        if len(arrays) == 2 and len(arrays[0].shape) == 2:
+            return cls._from_bimatrix(*arrays)
         g = Game.new_table(arrays[0].shape)
         for profile in itertools.product(*(range(arrays[0].shape[i])
                                          for i in range(len(g.players)))):
             for pl in range(len(g.players)):
                 g[profile][pl] = arrays[pl][profile]
         return g
-        
+
+    @classmethod
+    def _from_bimatrix(cls, a, b):
+        # Builds a two-player game from its payoff matrices in a single
+        # call, rather than setting payoffs outcome by outcome
+        cdef Game g
+        cdef Array[c_Rational] *payoffs1
+        cdef Array[c_Rational] *payoffs2
+        rows, cols = a.shape
+        payoffs1 = new Array[c_Rational](rows * cols)
+        payoffs2 = new Array[c_Rational](rows * cols)
+        try:
+            for i in range(rows):
+                for j in range(cols):
+                    setitem_array_rational(payoffs1, i*cols + j + 1,
+                                           _payoff_to_rational(a[i, j]))
+                    setitem_array_rational(payoffs2, i*cols + j + 1,
+                                           _payoff_to_rational(b[i, j]))
+            g = cls()
+            g.game = NewBimatrixTable(rows, cols, payoffs1, payoffs2)
+        finally:
+            del payoffs1
+            del payoffs2
+        return g
 
     @classmethod
     def read_game(cls, fn):
@@ -375,6 +375,10 @@ cdef extern from "util.h":
     c_Rational to_rational(char *)
     
     void setitem_array_int "setitem"(Array[int] *, int, int)
+    void setitem_array_rational "setitem"(Array[c_Rational] *, int, c_Rational)
+
+    c_Game NewBimatrixTable(int, int,
+                            Array[c_Rational] *, Array[c_Rational] *) except +ValueError
 
     void setitem_mspd_int "setitem"(c_MixedStrategyProfileDouble *, int, double)
     void setitem_mspd_strategy "setitem"(c_MixedStrategyProfileDouble *,
@@ -30,6 +30,7 @@
 #include <fstream>
 #include <sstream>
 #include "gambit/gambit.h"
+#include "gambit/bimatrix.h"
 #include "gambit/nash.h"
 
 using namespace std;
@@ -39,6 +40,11 @@ using namespace Gambit::Nash;
 inline Game NewTable(Array<int> *dim)
 { return NewTable(*dim); }
 
+inline Game NewBimatrixTable(int p_rows, int p_cols,
+			     Array<Rational> *p_payoffs1,
+			     Array<Rational> *p_payoffs2)
+{ return BimatrixGame(p_rows, p_cols, *p_payoffs1, *p_payoffs2).NewTable(); }
+
 Game ReadGame(char *fn) throw (InvalidFileException)
 { 
   std::ifstream f(fn);
@@ -72,3 +72,17 @@ class TestGambitStrategicGame(object):
         assert self.game.players[1].strategies[1].label == "Defect"
 
     
+
+    def test_game_from_bimatrix_arrays(self):
+        "Test creating a two-player game from its payoff matrices"
+        import numpy
+        import fractions
+        a = numpy.array([[1, 2, 3], [4, 5, 6]])
+        b = numpy.array([[fractions.Fraction(1, 2), 0, -1],
+                         [7, 8, fractions.Fraction(-3, 4)]], dtype=object)
+        g = gambit.Game.from_arrays(a, b)
+        assert len(g.players[0].strategies) == 2
+        assert len(g.players[1].strategies) == 3
+        assert g[1, 2][0] == 6
+        assert g[0, 0][1] == fractions.Fraction(1, 2)
+        assert g[1, 2][1] == fractions.Fraction(-3, 4)
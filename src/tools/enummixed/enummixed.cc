@@ -35,13 +35,17 @@ using namespace Gambit;
 using namespace Gambit::Nash;
 
 template <class T> void
-PrintCliques(const List<List<MixedStrategyProfile<T> > > &p_cliques,
+PrintCliques(const EnumMixedStrategySolution<T> &p_solution,
 	     shared_ptr<StrategyProfileRenderer<T> > p_renderer)
 {
-  for (int cl = 1; cl <= p_cliques.size(); cl++) {
-    for (int i = 1; i <= p_cliques[cl].size(); i++) {
-      p_renderer->Render(p_cliques[cl][i],
-			 "convex-" + lexical_cast<std::string>(cl)); 
+  for (int cl = 1; cl <= p_solution.NumCliques(); cl++) {
+    const Array<int> &clique1 = p_solution.GetClique(cl, 1);
+    const Array<int> &clique2 = p_solution.GetClique(cl, 2);
+    for (int i = 1; i <= clique1.Length(); i++) {
+      for (int j = 1; j <= clique2.Length(); j++) {
+	p_renderer->Render(p_solution.GetExtremeProfile(clique1[i], clique2[j]),
+			   "convex-" + lexical_cast<std::string>(cl)); 
+      }
     }
   }
 }
@@ -66,8 +70,13 @@ void PrintHelp(char *progname)
   std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -D               don't eliminate dominated strategies first\n";
+  std::cerr << "  -E               eliminate strategies strictly dominated by mixed\n";
+  std::cerr << "                   strategies first\n";
   std::cerr << "  -L               use lrslib for enumeration (experimental!)\n";
   std::cerr << "  -c               output connectedness information\n";
+  std::cerr << "  -t THREADS       enumerate vertices using THREADS threads\n";
+  std::cerr << "  -s DEPTH         with -t, search subtrees as separate tasks\n";
+  std::cerr << "                   down to DEPTH levels (default is 2)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -78,8 +87,8 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, uselrs = false, quiet = false, eliminate = true;
-  bool showConnect = false;
-  int numDecimals = 6;
+  bool showConnect = false, eliminateMixed = false;
+  int numDecimals = 6, numThreads = 1, splitDepth = 2;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -87,7 +96,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqcSL", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DEvhqcSLt:s:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -98,6 +107,9 @@ int main(int argc, char *argv[])
     case 'D':
       eliminate = false;
       break;
+    case 'E':
+      eliminateMixed = true;
+      break;
     case 'L':
       uselrs = true;
       break;
@@ -109,6 +121,12 @@ int main(int argc, char *argv[])
       break;
     case 'S':
       break;
+    case 't':
+      numThreads = atoi(optarg);
+      break;
+    case 's':
+      splitDepth = atoi(optarg);
+      break;
     case 'q':
       quiet = true;
       break;
@@ -144,35 +162,44 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (eliminateMixed) {
+      game = UndominatedRestriction(game, numThreads);
+    }
     if (uselrs) {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      EnumMixedLrsStrategySolver solver(renderer);
+      if (eliminateMixed) {
+	renderer = new RestrictedStrategyRenderer<Rational>(renderer);
+      }
+      EnumMixedLrsStrategySolver solver(renderer, numThreads);
       solver.Solve(game);
     }
     else if (useFloat) {
       shared_ptr<StrategyProfileRenderer<double> > renderer;
       renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						      numDecimals);
-      EnumMixedStrategySolver<double> solver(renderer);
+      if (eliminateMixed) {
+	renderer = new RestrictedStrategyRenderer<double>(renderer);
+      }
+      EnumMixedStrategySolver<double> solver(renderer, numThreads, splitDepth);
       shared_ptr<EnumMixedStrategySolution<double> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
-	List<List<MixedStrategyProfile<double> > > cliques =
-	  solution->GetCliques();
-	PrintCliques(cliques, renderer);
+	PrintCliques(*solution, renderer);
       }
     }
     else {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      EnumMixedStrategySolver<Rational> solver(renderer);
+      if (eliminateMixed) {
+	renderer = new RestrictedStrategyRenderer<Rational>(renderer);
+      }
+      EnumMixedStrategySolver<Rational> solver(renderer, numThreads, 
+						splitDepth);
       shared_ptr<EnumMixedStrategySolution<Rational> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
-	List<List<MixedStrategyProfile<Rational> > > cliques =
-	  solution->GetCliques();
-	PrintCliques(cliques, renderer);
+	PrintCliques(*solution, renderer);
       }
     }
     return 0;
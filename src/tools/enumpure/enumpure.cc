@@ -51,6 +51,9 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               report equilibria in strategies even for extensive games\n";
   std::cerr << "  -A               compute agent form equilibria\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -E               eliminate strategies strictly dominated by mixed\n";
+  std::cerr << "                   strategies first (not with -A or -P)\n";
+  std::cerr << "  -t THREADS       scan the table of a strategic game using THREADS threads\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -62,7 +65,8 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, reportStrategic = false, solveAgent = false, bySubgames = false;
-  bool printDetail = false;
+  bool printDetail = false, eliminate = false;
+  int numThreads = 1;
   
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -71,7 +75,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "DvhqASP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "DvhqASPEt:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -87,6 +91,12 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'E':
+      eliminate = true;
+      break;
+    case 't':
+      numThreads = atoi(optarg);
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -143,6 +153,12 @@ int main(int argc, char *argv[])
       }
     }
 
+    if (eliminate && !solveAgent && !bySubgames) {
+      // Any restriction is a strategic game, and is solved as one below
+      game = UndominatedRestriction(game, numThreads);
+      renderer = new RestrictedStrategyRenderer<Rational>(renderer);
+    }
+
     if (game->IsTree())  {
       if (bySubgames) {
 	shared_ptr<BehavSolver<Rational> > stage;
@@ -151,7 +167,7 @@ int main(int argc, char *argv[])
 	}
 	else {
 	  shared_ptr<StrategySolver<Rational> > substage = 
-	    new EnumPureStrategySolver();
+	    new EnumPureStrategySolver(0, numThreads);
 	  stage = new BehavViaStrategySolver<Rational>(substage);
 	}
 	SubgameBehavSolver<Rational> algorithm(stage, renderer);
@@ -163,13 +179,13 @@ int main(int argc, char *argv[])
 	  algorithm.Solve(game);
 	}
 	else {
-	  EnumPureStrategySolver algorithm(renderer);
+	  EnumPureStrategySolver algorithm(renderer, numThreads);
 	  algorithm.Solve(game);
 	}
       }
     }
     else {
-      EnumPureStrategySolver algorithm(renderer);
+      EnumPureStrategySolver algorithm(renderer, numThreads);
       algorithm.Solve(game);
     }
     return 0;
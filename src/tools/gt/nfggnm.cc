@@ -87,6 +87,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -n COUNT         number of perturbation vectors to generate\n";
   std::cerr << "  -s FILE          file containing perturbation vectors\n";
+  std::cerr << "  -E               eliminate strategies strictly dominated by mixed\n";
+  std::cerr << "                   strategies first\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -97,7 +99,7 @@ void PrintHelp(char *progname)
 int main(int argc, char *argv[])
 {
   opterr = 0;
-  bool quiet = false, verbose = false;
+  bool quiet = false, verbose = false, eliminate = false;
   int numDecimals = 6, numVectors = 1;
   std::string startFile;
 
@@ -109,7 +111,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:qvVhS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:n:s:qvVhSE", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -130,6 +132,9 @@ int main(int argc, char *argv[])
       break;
     case 'S':
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -164,16 +169,24 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = ReadGame(*input_stream), full = game;
     shared_ptr<StrategyProfileRenderer<double> > renderer;
     renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						    numDecimals);
+    if (eliminate) {
+      game = UndominatedRestriction(game);
+      renderer = new RestrictedStrategyRenderer<double>(renderer);
+    }
     NashGNMStrategySolver solver(renderer, verbose);
 
     List<MixedStrategyProfile<double> > perts;
     if (startFile != "") {
+      // Perturbation vectors are given on the game as read
       std::ifstream startPerts(startFile.c_str());
-      perts = ReadStrategyPerturbations(game, startPerts);
+      perts = ReadStrategyPerturbations(full, startPerts);
+      for (int i = 1; i <= perts.size(); i++) {
+	perts[i] = perts[i].Restrict(game);
+      }
     }
     else {
       // Generate the desired number of points randomly
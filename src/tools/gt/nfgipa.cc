@@ -49,6 +49,8 @@ void PrintHelp(char *progname)
 
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
+  std::cerr << "  -E               eliminate strategies strictly dominated by mixed\n";
+  std::cerr << "                   strategies first\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
@@ -60,7 +62,7 @@ void PrintHelp(char *progname)
 int main(int argc, char *argv[])
 {
   opterr = 0;
-  bool quiet = false, verbose = false;
+  bool quiet = false, verbose = false, eliminate = false;
   int numDecimals = 6;
 
   int long_opt_index = 0;
@@ -71,7 +73,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:vVqhS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:vVqhSE", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -86,6 +88,9 @@ int main(int argc, char *argv[])
       break;
     case 'S':
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -124,6 +129,10 @@ int main(int argc, char *argv[])
     shared_ptr<StrategyProfileRenderer<double> > renderer;
     renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						    numDecimals);
+    if (eliminate) {
+      game = UndominatedRestriction(game);
+      renderer = new RestrictedStrategyRenderer<double>(renderer);
+    }
     NashIPAStrategySolver solver(renderer);
     solver.Solve(game);
     return 0;
@@ -50,11 +50,17 @@ void PrintHelp(char *progname)
   std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -S               use strategic game\n";
+  std::cerr << "  -H               pivot in floating point, computing each equilibrium\n";
+  std::cerr << "                   exactly (strategic games; not with -d or -t)\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
   std::cerr << "  -e EQA           terminate after finding EQA equilibria\n";
   std::cerr << "                   (default is to find all accessible equilbria\n";
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
   std::cerr << "                   (only if number of equilibria sought is not 1)\n";
+  std::cerr << "  -E               eliminate strategies strictly dominated by mixed\n";
+  std::cerr << "                   strategies first (strategic games)\n";
+  std::cerr << "  -t THREADS       search using THREADS threads (strategic games;\n";
+  std::cerr << "                   equilibria may be reported in any order)\n";
   std::cerr << "  -D               print detailed information about equilibria\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -67,8 +73,8 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, useStrategic = false, bySubgames = false, quiet = false;
-  bool printDetail = false;
-  int numDecimals = 6, stopAfter = 0, maxDepth = 0;
+  bool printDetail = false, useHybrid = false, eliminate = false;
+  int numDecimals = 6, stopAfter = 0, maxDepth = 0, numThreads = 1;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -76,7 +82,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqSHPEe:r:t:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -99,9 +105,18 @@ int main(int argc, char *argv[])
     case 'r':
       maxDepth = atoi(optarg);
       break;
+    case 't':
+      numThreads = atoi(optarg);
+      break;
     case 'S':
       useStrategic = true;
       break;
+    case 'H':
+      useHybrid = true;
+      break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'P':
       bySubgames = true;
       break;
@@ -138,6 +153,9 @@ int main(int argc, char *argv[])
   try {
     Game game = ReadGame(*input_stream);
     if (!game->IsTree() || useStrategic) {
+      if (eliminate) {
+	game = UndominatedRestriction(game, numThreads);
+      }
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
 	if (printDetail)  {
@@ -147,8 +165,11 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
+	if (eliminate) {
+	  renderer = new RestrictedStrategyRenderer<double>(renderer);
+	}
 	NashLcpStrategySolver<double> algorithm(stopAfter, maxDepth,
-						renderer);
+						renderer, numThreads);
 	algorithm.Solve(game);
       }
       else {
@@ -159,9 +180,18 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
-	NashLcpStrategySolver<Rational> algorithm(stopAfter, maxDepth,
-						  renderer);
-	algorithm.Solve(game);
+	if (eliminate) {
+	  renderer = new RestrictedStrategyRenderer<Rational>(renderer);
+	}
+	if (useHybrid) {
+	  NashLcpHybridStrategySolver algorithm(stopAfter, maxDepth, renderer);
+	  algorithm.Solve(game);
+	}
+	else {
+	  NashLcpStrategySolver<Rational> algorithm(stopAfter, maxDepth,
+						    renderer, numThreads);
+	  algorithm.Solve(game);
+	}
       }
     }
     else {
@@ -51,6 +51,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -n COUNT         number of starting points to generate\n";
   std::cerr << "  -s FILE          file containing starting points\n";
+  std::cerr << "  -E               eliminate strategies strictly dominated by mixed\n";
+  std::cerr << "                   strategies first (strategic games)\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "                   (default is to only show equilibria)\n";
@@ -134,6 +136,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, useStrategic = false, useRandom = false, verbose = false;
+  bool eliminate = false;
   int numTries = 10;
   int maxitsN = 100;
   int numDecimals = 6;
@@ -148,7 +151,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:hqVvS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:n:s:hqVvSE", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -167,6 +170,9 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'q':
       quiet = true;
       break;
@@ -206,10 +212,18 @@ int main(int argc, char *argv[])
   try {
     Game game = ReadGame(*input_stream);
     if (!game->IsTree() || useStrategic) {
+      Game full = game;
+      if (eliminate) {
+	game = UndominatedRestriction(game);
+      }
       List<MixedStrategyProfile<double> > starts;
       if (startFile != "") {
+	// Starting points are given on the game as read
 	std::ifstream startPoints(startFile.c_str());
-	starts = ReadStrategyProfiles(game, startPoints);
+	starts = ReadStrategyProfiles(full, startPoints);
+	for (int i = 1; i <= starts.size(); i++) {
+	  starts[i] = starts[i].Restrict(game);
+	}
       }
       else {
 	// Generate the desired number of points randomly
@@ -220,6 +234,9 @@ int main(int argc, char *argv[])
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
 	renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 							numDecimals);
+	if (eliminate) {
+	  renderer = new RestrictedStrategyRenderer<double>(renderer);
+	}
 	NashLiapStrategySolver algorithm(maxitsN, verbose, renderer);
 	algorithm.Solve(starts[i]);
       }
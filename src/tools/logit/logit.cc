@@ -53,6 +53,7 @@ void PrintHelp(char *progname)
   std::cerr << "  -s STEP          initial stepsize (default is .03)\n";
   std::cerr << "  -a ACCEL         maximum acceleration (default is 1.1)\n";
   std::cerr << "  -m MAXLAMBDA     stop when reaching MAXLAMBDA (default is 1000000)\n";
+  std::cerr << "  -b               use Broyden updates of the Jacobian between steps\n";
   std::cerr << "  -l LAMBDA        compute QRE at `lambda` accurately\n";
   std::cerr << "  -L FILE          compute maximum likelihood estimates;\n";
   std::cerr << "                   read strategy frequencies from FILE\n";
@@ -96,6 +97,7 @@ int main(int argc, char *argv[])
   std::string mleFile = "";
   double maxDecel = 1.1;
   double hStart = 0.03;
+  bool updating = false;
   double targetLambda = -1.0;
   bool fullGraph = true;
   int decimals = 6;
@@ -107,7 +109,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSL:p:l:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:s:a:m:bvqehSL:p:l:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -126,6 +128,9 @@ int main(int argc, char *argv[])
     case 'm':
       maxLambda = atof(optarg);
       break;
+    case 'b':
+      updating = true;
+      break;
     case 'e':
       fullGraph = false;
       break;
@@ -186,6 +191,7 @@ int main(int argc, char *argv[])
       StrategicQREEstimator tracer;
       tracer.SetMaxDecel(maxDecel);
       tracer.SetStepsize(hStart);
+      tracer.SetUpdating(updating);
       tracer.SetFullGraph(fullGraph);
       tracer.SetDecimals(decimals);
       tracer.Estimate(start, frequencies, std::cout, maxLambda, 1.0);
@@ -197,6 +203,7 @@ int main(int argc, char *argv[])
       StrategicQREPathTracer tracer;
       tracer.SetMaxDecel(maxDecel);
       tracer.SetStepsize(hStart);
+      tracer.SetUpdating(updating);
       tracer.SetFullGraph(fullGraph);
       tracer.SetDecimals(decimals);
       if (targetLambda > 0.0) {
@@ -211,6 +218,7 @@ int main(int argc, char *argv[])
       AgentQREPathTracer tracer;
       tracer.SetMaxDecel(maxDecel);
       tracer.SetStepsize(hStart);
+      tracer.SetUpdating(updating);
       tracer.SetFullGraph(fullGraph);
       tracer.SetDecimals(decimals);
       tracer.TraceAgentPath(start, std::cout, maxLambda, 1.0, targetLambda);
@@ -23,9 +23,10 @@
 #include <cmath>
 #include <algorithm>   // for std::max
 #include <iostream>
+#include <vector>
 
 #include <gambit/gambit.h>
-#include <gambit/sqmatrix.h>
+#include <gambit/kernels.h>
 #include "path.h"
 
 namespace Gambit {
@@ -35,75 +36,284 @@ namespace Gambit {
 //----------------------------------------------------------------------------
 
 namespace {
-  
-inline double sqr(double x) { return x*x; }
 
-void Givens(Matrix<double> &b, Matrix<double> &q,
-            double &c1, double &c2, int l1, int l2, int l3)
+//
+// Maintains a factorization of the Jacobian J of the system of equations,
+// an m x (m+1) matrix, in the form J = [L 0] Q^T, with L lower triangular
+// and Q orthogonal.  This is the transpose of the QR decomposition
+// described by Allgower and Georg.
+//
+// Q is not formed explicitly.  It is kept as the product of the Householder
+// reflections which reduce J to [L 0], followed by the plane rotations
+// accumulated by any subsequent Broyden updates.  Rows of J, L and the
+// reflections are stored contiguously, so that the inner loops are
+// products and updates along rows.
+//
+class JacobianFactorization {
+public:
+  explicit JacobianFactorization(int p_numVars);
+
+  /// Factors the Jacobian, which is supplied transposed, in the layout
+  /// produced by PathTracer::EquationSystem::GetJacobian()
+  void Factor(const Matrix<double> &p_jacobian);
+  /// Replaces J by the Broyden update J + r s^T / (s^T s) for a step s
+  /// and residual r
+  void Update(const Vector<double> &p_step, const Vector<double> &p_residual);
+  /// Number of updates since the last factorization
+  int NumUpdates(void) const { return m_numUpdates; }
+
+  /// Computes the unit tangent t with J t = 0, oriented so that
+  /// det [J^T t] > 0
+  void GetTangent(Vector<double> &p_tangent) const;
+  /// Computes the Newton step s = -J^+ y, and its length
+  void NewtonStep(const Vector<double> &p_value, 
+		  Vector<double> &p_step, double &p_length) const;
+
+private:
+  struct Rotation {
+    int col;
+    double c, s;
+  };
+
+  // Number of rows in a panel of the blocked factorization
+  static const int c_blockSize = 32;
+
+  int m_rows, m_cols;
+  Matrix<double> m_house, m_lower;
+  Vector<double> m_tau;
+  std::vector<Rotation> m_rotations;
+  int m_numUpdates, m_reflections;
+  mutable Vector<double> m_work;
+
+  void Reflect(int p_index, double *p_vector) const;
+  void MakeReflection(int p_index);
+  void RotateColumns(int p_col, double c, double s, int p_firstRow);
+  void MultiplyQ(double *p_vector) const;
+  void MultiplyQTranspose(double *p_vector) const;
+};
+
+JacobianFactorization::JacobianFactorization(int p_numVars)
+  : m_rows(p_numVars - 1), m_cols(p_numVars),
+    m_house(p_numVars - 1, p_numVars), m_lower(p_numVars - 1, p_numVars),
+    m_tau(p_numVars - 1), m_numUpdates(0), m_reflections(0),
+    m_work(p_numVars)
+{ }
+
+// Applies reflection number p_index to the m_cols-vector p_vector
+inline void JacobianFactorization::Reflect(int p_index,
+					   double *p_vector) const
 {
-  if (fabs(c1) + fabs(c2) == 0.0) {
+  if (m_tau[p_index] == 0.0) {
     return;
   }
+  const double *v = m_house.RowData(p_index) + (p_index - 1);
+  double *x = p_vector + (p_index - 1);
+  int n = m_cols - p_index + 1;
+  kernels::Axpy(-m_tau[p_index] * kernels::Dot(v, x, n), v, x, n);
+}
 
-  double sn;
-  if (fabs(c2) >= fabs(c1)) {
-    sn = std::sqrt(1.0 + sqr(c1/c2)) * fabs(c2);
+// Computes the reflection which annihilates the entries of row p_index
+// beyond the diagonal, storing it in place of those entries
+void JacobianFactorization::MakeReflection(int p_index)
+{
+  double *x = m_house.RowData(p_index) + (p_index - 1);
+  int n = m_cols - p_index + 1;
+  double norm = std::sqrt(kernels::Dot(x, x, n));
+  double *lower = m_lower.RowData(p_index);
+
+  if (norm == 0.0) {
+    m_tau[p_index] = 0.0;
+    lower[p_index - 1] = 0.0;
+    return;
   }
-  else {
-    sn = std::sqrt(1.0 + sqr(c2/c1)) * fabs(c1);
+
+  double alpha = (x[0] > 0.0) ? -norm : norm;
+  m_tau[p_index] = 1.0 / (norm * (norm + fabs(x[0])));
+  x[0] -= alpha;
+  lower[p_index - 1] = alpha;
+  m_reflections++;
+}
+
+void JacobianFactorization::Factor(const Matrix<double> &p_jacobian)
+{
+  for (int j = 1; j <= m_cols; j++) {
+    const double *column = p_jacobian.RowData(j);
+    for (int i = 1; i <= m_rows; i++) {
+      m_house.RowData(i)[j - 1] = column[i - 1];
+    }
   }
-  double s1 = c1/sn;
-  double s2 = c2/sn;
-
-  for (int k = 1; k <= q.NumColumns(); k++) {
-    double sv1 = q(l1, k);
-    double sv2 = q(l2, k);
-    q(l1, k) = s1 * sv1 + s2 * sv2;
-    q(l2, k) = -s2 * sv1 + s1 * sv2;
+
+  m_lower = 0.0;
+  m_rotations.clear();
+  m_numUpdates = 0;
+  m_reflections = 0;
+
+  // Each panel of rows is reduced in turn, applying the reflections of
+  // earlier rows in the panel as each row is reached; the panel's
+  // reflections are then applied to each of the remaining rows while
+  // that row is in cache.
+  for (int first = 1; first <= m_rows; first += c_blockSize) {
+    int last = std::min(first + c_blockSize - 1, m_rows);
+    for (int i = first; i <= last; i++) {
+      double *row = m_house.RowData(i);
+      for (int k = first; k < i; k++) {
+	Reflect(k, row);
+      }
+      MakeReflection(i);
+    }
+    for (int i = last + 1; i <= m_rows; i++) {
+      double *row = m_house.RowData(i);
+      for (int k = first; k <= last; k++) {
+	Reflect(k, row);
+      }
+    }
   }
 
-  for (int k = l3; k <= b.NumColumns(); k++) {
-    double sv1 = b(l1, k);
-    double sv2 = b(l2, k);
-    b(l1, k) = s1 * sv1 + s2 * sv2;
-    b(l2, k) = -s2 * sv1 + s1 * sv2;
+  for (int i = 1; i <= m_rows; i++) {
+    const double *row = m_house.RowData(i);
+    double *lower = m_lower.RowData(i);
+    for (int k = 1; k < i; k++) {
+      lower[k - 1] = row[k - 1];
+    }
   }
+}
 
-  c1 = sn;
-  c2 = 0.0;
+// Computes Q x, overwriting x
+void JacobianFactorization::MultiplyQ(double *p_vector) const
+{
+  for (int r = m_rotations.size() - 1; r >= 0; r--) {
+    const Rotation &rot = m_rotations[r];
+    double *x = p_vector + (rot.col - 1);
+    double x0 = x[0], x1 = x[1];
+    x[0] = rot.c * x0 - rot.s * x1;
+    x[1] = rot.s * x0 + rot.c * x1;
+  }
+  for (int k = m_rows; k >= 1; k--) {
+    Reflect(k, p_vector);
+  }
 }
 
-void QRDecomp(Matrix<double> &b, Matrix<double> &q)
+// Computes Q^T x, overwriting x
+void JacobianFactorization::MultiplyQTranspose(double *p_vector) const
 {
-  q.MakeIdent();
-  for (int m = 1; m <= b.NumColumns(); m++) {
-    for (int k = m + 1; k <= b.NumRows(); k++) {
-      Givens(b, q, b(m, m), b(k, m), m, k, m + 1);
-    }
+  for (int k = 1; k <= m_rows; k++) {
+    Reflect(k, p_vector);
+  }
+  for (size_t r = 0; r < m_rotations.size(); r++) {
+    const Rotation &rot = m_rotations[r];
+    double *x = p_vector + (rot.col - 1);
+    double x0 = x[0], x1 = x[1];
+    x[0] = rot.c * x0 + rot.s * x1;
+    x[1] = -rot.s * x0 + rot.c * x1;
   }
 }
 
-void NewtonStep(Matrix<double> &q, Matrix<double> &b,
-                Vector<double> &u, Vector<double> &y,
-		double &d)
+// Multiplies [L 0] on the right by the rotation in the plane of
+// columns p_col and p_col+1, and records it as a factor of Q
+void JacobianFactorization::RotateColumns(int p_col, double c, double s,
+					  int p_firstRow)
 {
-  for (int k = 1; k <= b.NumColumns(); k++) {
-    for (int l = 1; l <= k - 1; l++) {
-      y[k] -= b(l, k) * y[l];
+  for (int i = std::max(p_firstRow, 1); i <= m_rows; i++) {
+    double *x = m_lower.RowData(i) + (p_col - 1);
+    double x0 = x[0], x1 = x[1];
+    x[0] = c * x0 + s * x1;
+    x[1] = -s * x0 + c * x1;
+  }
+  Rotation rot;
+  rot.col = p_col;  rot.c = c;  rot.s = s;
+  m_rotations.push_back(rot);
+}
+
+//
+// The update is J + a s^T = ([L 0] + a b^T) Q^T, with b = Q^T s.  Rotations
+// reduce b to a multiple of the first unit vector, leaving [L 0] lower
+// Hessenberg; after the rank-one term is added to the first column,
+// further rotations restore the triangular form.  This is the scheme of
+// Allgower and Georg, section 16.3, transposed.
+//
+void JacobianFactorization::Update(const Vector<double> &p_step,
+				   const Vector<double> &p_residual)
+{
+  double norm2 = p_step * p_step;
+  if (norm2 == 0.0) {
+    return;
+  }
+
+  double *b = &m_work[1];
+  for (int j = 0; j < m_cols; j++) {
+    b[j] = p_step[j + 1];
+  }
+  MultiplyQTranspose(b);
+
+  for (int k = m_cols - 1; k >= 1; k--) {
+    if (b[k] == 0.0) {
+      continue;
     }
-    y[k] /= b(k, k);
+    double r = hypot(b[k - 1], b[k]);
+    double c = b[k - 1] / r, s = b[k] / r;
+    b[k - 1] = r;
+    b[k] = 0.0;
+    RotateColumns(k, c, s, k - 1);
   }
 
-  d = 0.0;
-  for (int k = 1; k <= b.NumRows(); k++) {
-    double s = 0.0;
-    for (int l = 1; l <= b.NumColumns(); l++) {
-      s += q(l, k) * y[l];
+  for (int i = 1; i <= m_rows; i++) {
+    m_lower.RowData(i)[0] += b[0] * p_residual[i] / norm2;
+  }
+
+  for (int k = 1; k <= m_rows; k++) {
+    double *row = m_lower.RowData(k);
+    if (row[k] == 0.0) {
+      continue;
+    }
+    double r = hypot(row[k - 1], row[k]);
+    RotateColumns(k, row[k - 1] / r, row[k] / r, k);
+    row[k] = 0.0;
+  }
+
+  m_numUpdates++;
+}
+
+void JacobianFactorization::GetTangent(Vector<double> &p_tangent) const
+{
+  double *t = &m_work[1];
+  for (int j = 0; j < m_cols; j++) {
+    t[j] = 0.0;
+  }
+  t[m_cols - 1] = 1.0;
+  MultiplyQ(t);
+
+  // det [J^T t] = det(Q) * prod L(i,i); reflections have determinant -1
+  // and rotations +1.
+  bool negative = (m_reflections % 2 == 1);
+  for (int i = 1; i <= m_rows; i++) {
+    if (m_lower(i, i) < 0.0) {
+      negative = !negative;
     }
-    u[k] -= s;
-    d += s * s;
   }
-  d = std::sqrt(d);
+  for (int j = 1; j <= m_cols; j++) {
+    p_tangent[j] = (negative) ? -t[j - 1] : t[j - 1];
+  }
+}
+
+void JacobianFactorization::NewtonStep(const Vector<double> &p_value,
+				       Vector<double> &p_step,
+				       double &p_length) const
+{
+  // Solve L z = y, then s = -Q [z 0]^T
+  double *z = &m_work[1];
+  for (int i = 1; i <= m_rows; i++) {
+    const double *row = m_lower.RowData(i);
+    z[i - 1] = (p_value[i] - kernels::Dot(row, z, i - 1)) / row[i - 1];
+  }
+  z[m_cols - 1] = 0.0;
+  MultiplyQ(z);
+
+  double length = 0.0;
+  for (int j = 1; j <= m_cols; j++) {
+    p_step[j] = -z[j - 1];
+    length += z[j - 1] * z[j - 1];
+  }
+  p_length = std::sqrt(length);
 }
 
 }   // end anonymous namespace
@@ -128,20 +338,23 @@ PathTracer::TracePath(const EquationSystem &p_system,
   double h = m_hStart;             // initial stepsize
   const double c_hmin = 1.0e-8;    // minimal stepsize
   const int c_maxIter = 100;       // maximum iterations in corrector
+  const int c_maxUpdates = 25;     // maximum Broyden updates between
+                                   // factorizations
   
   bool newton = false;             // using Newton steplength (for zero-finding)
+  bool refactor = true;            // evaluate the Jacobian at the next step
 
-  Vector<double> u(x.Length()), restart(x.Length());
+  Vector<double> u(x.Length()), restart(x.Length()), step(x.Length());
   // t is current tangent at x; newT is tangent at u, which is the next point.
   Vector<double> t(x.Length()), newT(x.Length());
   Vector<double> y(x.Length() - 1);
   Matrix<double> b(x.Length(), x.Length() - 1);
-  SquareMatrix<double> q(x.Length());
+  JacobianFactorization jacobian(x.Length());
 
   p_callback(x, false);
   p_system.GetJacobian(x, b);
-  QRDecomp(b, q);
-  q.GetRow(q.NumRows(), t);
+  jacobian.Factor(b);
+  jacobian.GetTangent(t);
   
   while (x[x.Length()] >= 0.0 && x[x.Length()] < p_maxLambda) {
     bool accept = true;
@@ -156,12 +369,22 @@ PathTracer::TracePath(const EquationSystem &p_system,
 
     // Predictor step
     for (int k = 1; k <= x.Length(); k++) {
-      u[k] = x[k] + h * p_omega * t[k];
+      step[k] = h * p_omega * t[k];
+      u[k] = x[k] + step[k];
+    }
+
+    // When updating, the factorization carries over from the last step,
+    // and the Jacobian is only evaluated again after a step fails or
+    // the number of updates reaches its limit.
+    bool fresh = (!m_updating || refactor ||
+		  jacobian.NumUpdates() >= c_maxUpdates);
+    if (fresh) {
+      p_system.GetJacobian(u, b);
+      jacobian.Factor(b);
+      refactor = false;
     }
 
     double decel = 1.0 / m_maxDecel;  // initialize deceleration factor
-    p_system.GetJacobian(u, b);
-    QRDecomp(b, q);
 
     int iter = 1;
     double disto = 0.0;
@@ -169,7 +392,12 @@ PathTracer::TracePath(const EquationSystem &p_system,
       double dist;
 
       p_system.GetValue(u, y);
-      NewtonStep(q, b, u, y, dist); 
+      if (m_updating && (iter >= 2 || !fresh)) {
+	// The model predicts zero at u, so the residual is the value
+	jacobian.Update(step, y);
+      }
+      jacobian.NewtonStep(y, step, dist);
+      u += step;
 
       if (dist >= c_maxDist) {
 	accept = false;
@@ -203,6 +431,11 @@ PathTracer::TracePath(const EquationSystem &p_system,
     }
 
     if (!accept) {
+      if (!fresh) {
+	// Retry the step with the Jacobian itself before reducing it
+	refactor = true;
+	continue;
+      }
       h /= m_maxDecel;   // PC not accepted; change stepsize and retry
       if (fabs(h) <= c_hmin) {
 	p_callback(x, true);
@@ -222,7 +455,7 @@ PathTracer::TracePath(const EquationSystem &p_system,
     }
 
     // Obtain the tangent at the next step
-    q.GetRow(q.NumRows(), newT); 
+    jacobian.GetTangent(newT);
 
     // If we are at a bifurcation point, the orientation of the tangent
     // will flip.  This will confuse many criterion functions, especially
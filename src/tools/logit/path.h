@@ -94,8 +94,14 @@ public:
   void SetStepsize(double p_hStart) { m_hStart = p_hStart; }
   double GetStepsize(void) const { return m_hStart; }
 
+  // If set, the factorization of the Jacobian is carried from step to
+  // step using Broyden updates, and the Jacobian is evaluated only when
+  // a step fails to converge.
+  void SetUpdating(bool p_updating) { m_updating = p_updating; }
+  bool GetUpdating(void) const { return m_updating; }
+
 protected:
-  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03)
+  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_updating(false)
     { } 
   virtual ~PathTracer() { }
 
@@ -106,6 +112,7 @@ protected:
 
 private:
   double m_maxDecel, m_hStart;
+  bool m_updating;
 };
 
 }  // end namespace Gambit
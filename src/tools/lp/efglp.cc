@@ -23,12 +23,46 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <map>
 #include "gambit/gambit.h"
 #include "gambit/linalg/lpsolve.h"
+#include "gambit/linalg/sparselp.h"
 #include "efglp.h"
 
 using namespace Gambit;
 
+namespace {
+
+//
+// The constraint matrix of the sequence form, held by its nonzero
+// entries, which BuildConstraintMatrix fills in as it would a Matrix.
+//
+class SparseConstraintMatrix {
+public:
+  double &operator()(int i, int j)
+  { return m_entries[std::make_pair(j, i)]; }
+
+  void GetColumns(std::vector<Gambit::linalg::SparseColumn> &) const;
+
+private:
+  // Entries are keyed by column, then row
+  std::map<std::pair<int, int>, double> m_entries;
+};
+
+void 
+SparseConstraintMatrix::GetColumns(std::vector<Gambit::linalg::SparseColumn> &p_columns) const
+{
+  for (std::map<std::pair<int, int>, double>::const_iterator entry = m_entries.begin();
+       entry != m_entries.end(); ++entry) {
+    if (entry->second != 0.0) {
+      p_columns[entry->first.first].push_back(std::make_pair(entry->first.second,
+							     entry->second));
+    }
+  }
+}
+
+}  // end anonymous namespace
+
 
 template <class T> class NashLpBehavSolver<T>::GameData {
 public:
@@ -38,8 +72,9 @@ public:
   
   GameData(const BehaviorSupportProfile &);
 
+  template <class M>
   void BuildConstraintMatrix(const BehaviorSupportProfile &,
-			     Matrix<T> &, const GameNode &, const T &,
+			     M &, const GameNode &, const T &,
 			     int, int, int, int);
   void GetBehavior(const BehaviorSupportProfile &, MixedBehaviorProfile<T> &v,
 		   const Array<T> &, const Array<T> &,
@@ -78,9 +113,9 @@ NashLpBehavSolver<T>::GameData::GameData(const BehaviorSupportProfile &p_support
 //
 // Recursively fills the constraint matrix A for the subtree rooted at 'n'.
 //
-template <class T> void
+template <class T> template <class M> void
 NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(const BehaviorSupportProfile &p_support,
-						      Matrix<T> &A, 
+						      M &A, 
 						      const GameNode &n, 
 						      const T &prob,
 						      int s1, int s2, 
@@ -149,6 +184,7 @@ NashLpBehavSolver<T>::SolveLP(const Matrix<T> &A,
 			      int nequals,
 			      Array<T> &p_primal, Array<T> &p_dual) const
 {
+  IntegerArena arena;
   Gambit::linalg::LPSolve<T> LP(A, b, c, nequals);
   const Gambit::linalg::BFS<T> &cbfs(LP.OptimumBFS());
   
@@ -172,6 +208,75 @@ NashLpBehavSolver<T>::SolveLP(const Matrix<T> &A,
   return true;
 }
 
+//
+// Sets up the LP from the sequence form, and solves it.
+//
+template <class T> bool
+NashLpBehavSolver<T>::SolveSequenceForm(const BehaviorSupportProfile &p_support,
+					GameData &data,
+					Array<T> &p_primal,
+					Array<T> &p_dual) const
+{
+  Matrix<T> A(1, data.ns1 + data.ni2, 1, data.ns2 + data.ni1);
+  Vector<T> b(1, data.ns1 + data.ni2);
+  Vector<T> c(1, data.ns2 + data.ni1);
+
+  A = (T) 0;
+  b = (T) 0;
+  c = (T) 0;
+
+  data.BuildConstraintMatrix(p_support, A, p_support.GetGame()->GetRoot(), 
+			     (T) 1, 1, 1, 0, 0);
+  A(1, data.ns2 + 1) = (T) -1;
+  A(data.ns1 + 1, 1) = (T) 1;
+
+  b[data.ns1 + 1] = (T) 1;
+  c[data.ns2 + 1] = (T) -1;
+
+  return SolveLP(A, b, c, data.ni2, p_primal, p_dual);
+}
+
+//
+// In floating point, the constraint matrix is only ever held sparsely,
+// and the LP is solved by the revised simplex method.
+//
+template <> bool
+NashLpBehavSolver<double>::SolveSequenceForm(const BehaviorSupportProfile &p_support,
+					     GameData &data,
+					     Array<double> &p_primal,
+					     Array<double> &p_dual) const
+{
+  SparseConstraintMatrix A;
+  Vector<double> b(1, data.ns1 + data.ni2);
+  Vector<double> c(1, data.ns2 + data.ni1);
+
+  b = 0.0;
+  c = 0.0;
+
+  data.BuildConstraintMatrix(p_support, A, p_support.GetGame()->GetRoot(), 
+			     1.0, 1, 1, 0, 0);
+  A(1, data.ns2 + 1) = -1.0;
+  A(data.ns1 + 1, 1) = 1.0;
+
+  b[data.ns1 + 1] = 1.0;
+  c[data.ns2 + 1] = -1.0;
+
+  std::vector<Gambit::linalg::SparseColumn> columns(data.ns2 + data.ni1 + 1);
+  A.GetColumns(columns);
+  Gambit::linalg::SparseLPSolve LP(columns, b, c, data.ni2);
+  if (!LP.IsFeasible() || !LP.IsBounded()) {
+    return false;
+  }
+
+  for (int i = 1; i <= p_primal.Length(); i++) {
+    p_primal[i] = LP.OptimumVector()[i];
+  }
+  for (int i = 1; i <= p_dual.Length(); i++) {
+    p_dual[i] = LP.DualVector()[i];
+  }
+  return true;
+}
+
 //
 // Recursively construct the behavior profile from the sequence form
 // solution represented by 'p_primal' (containing player 2's
@@ -248,29 +353,11 @@ NashLpBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
 
-  Gambit::linalg::BFS<T> cbfs;
-  
   GameData data(p_support.GetGame());
 
-  Matrix<T> A(1, data.ns1 + data.ni2, 1, data.ns2 + data.ni1);
-  Vector<T> b(1, data.ns1 + data.ni2);
-  Vector<T> c(1, data.ns2 + data.ni1);
-
-  A = (T) 0;
-  b = (T) 0;
-  c = (T) 0;
-
-  data.BuildConstraintMatrix(p_support, A, p_support.GetGame()->GetRoot(), 
-			     (T) 1, 1, 1, 0, 0);
-  A(1, data.ns2 + 1) = (T) -1;
-  A(data.ns1 + 1, 1) = (T) 1;
-
-  b[data.ns1 + 1] = (T) 1;
-  c[data.ns2 + 1] = (T) -1;
-
-  Array<T> primal(A.NumColumns()), dual(A.NumRows());
+  Array<T> primal(data.ns2 + data.ni1), dual(data.ns1 + data.ni2);
   List<MixedBehaviorProfile<T> > solution;
-  if (SolveLP(A, b, c, data.ni2, primal, dual)) {
+  if (SolveSequenceForm(p_support, data, primal, dual)) {
     MixedBehaviorProfile<T> profile(p_support);
     data.GetBehavior(p_support, profile, primal, dual,
 		     p_support.GetGame()->GetRoot(), 1, 1);
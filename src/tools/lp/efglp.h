@@ -41,6 +41,8 @@ private:
 
   virtual bool SolveLP(const Matrix<T> &, const Vector<T> &, const Vector<T> &,
 		       int, Array<T> &, Array<T> &) const;
+  bool SolveSequenceForm(const BehaviorSupportProfile &, GameData &,
+			 Array<T> &, Array<T> &) const;
 };
 
 
@@ -53,6 +53,8 @@ void PrintHelp(char *progname)
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -E               eliminate strategies strictly dominated by mixed\n";
+  std::cerr << "                   strategies first (strategic games)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -64,7 +66,7 @@ int main(int argc, char *argv[])
   int c;
   int numDecimals = 6;
   bool useFloat = false, useStrategic = false, quiet = false, printDetail = false;
-  bool bySubgames = false;
+  bool bySubgames = false, eliminate = false;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -72,7 +74,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvqhSP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvqhSPE", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -95,6 +97,9 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -128,6 +133,9 @@ int main(int argc, char *argv[])
   try {
     Gambit::Game game = Gambit::ReadGame(*input_stream);
     if (!game->IsTree() || useStrategic) {
+      if (eliminate) {
+	game = UndominatedRestriction(game);
+      }
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
 	if (printDetail)  {
@@ -137,6 +145,9 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
+	if (eliminate) {
+	  renderer = new RestrictedStrategyRenderer<double>(renderer);
+	}
 	NashLpStrategySolver<double> algorithm(renderer);
 	algorithm.Solve(game);
       }
@@ -148,6 +159,9 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
+	if (eliminate) {
+	  renderer = new RestrictedStrategyRenderer<Rational>(renderer);
+	}
 	NashLpStrategySolver<Rational> algorithm(renderer);
 	algorithm.Solve(game);
       }
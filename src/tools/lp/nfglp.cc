@@ -24,7 +24,9 @@
 #include <unistd.h>
 #include <iostream>
 #include "gambit/gambit.h"
+#include "gambit/bimatrix.h"
 #include "gambit/linalg/lpsolve.h"
+#include "gambit/linalg/sparselp.h"
 #include "nfglp.h"
 
 using namespace Gambit;
@@ -48,6 +50,7 @@ NashLpStrategySolver<T>::SolveLP(const Matrix<T> &A,
 				 int nequals,
 				 Array<T> &p_primal, Array<T> &p_dual) const
 {
+  IntegerArena arena;
   Gambit::linalg::LPSolve<T> LP(A, b, c, nequals);
   const Gambit::linalg::BFS<T> &cbfs(LP.OptimumBFS());
 
@@ -71,6 +74,40 @@ NashLpStrategySolver<T>::SolveLP(const Matrix<T> &A,
   return true;
 }
 
+//
+// In floating point, the LP is solved by the revised simplex method on
+// the nonzero entries of A.
+//
+template <> bool
+NashLpStrategySolver<double>::SolveLP(const Matrix<double> &A, 
+				      const Vector<double> &b,
+				      const Vector<double> &c,
+				      int nequals,
+				      Array<double> &p_primal,
+				      Array<double> &p_dual) const
+{
+  std::vector<Gambit::linalg::SparseColumn> columns(A.NumColumns() + 1);
+  for (int j = 1; j <= A.NumColumns(); j++) {
+    for (int i = 1; i <= A.NumRows(); i++) {
+      if (A(i,j) != 0.0) {
+	columns[j].push_back(std::make_pair(i, A(i,j)));
+      }
+    }
+  }
+  Gambit::linalg::SparseLPSolve LP(columns, b, c, nequals);
+  if (!LP.IsFeasible() || !LP.IsBounded()) {
+    return false;
+  }
+
+  for (int i = 1; i <= A.NumColumns(); i++) {
+    p_primal[i] = LP.OptimumVector()[i];
+  }
+  for (int i = 1; i <= A.NumRows(); i++) {
+    p_dual[i] = LP.DualVector()[i];
+  }
+  return true;
+}
+
 //
 // Compute and print one equilibrium by solving a linear program based
 // on the strategic game representation.
@@ -88,22 +125,19 @@ NashLpStrategySolver<T>::Solve(const Game &p_game) const
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
 
-  int m = p_game->Players()[1]->Strategies().size();
-  int k = p_game->Players()[2]->Strategies().size();
+  BimatrixGame bimatrix(p_game);
+  int m = bimatrix.NumRows();
+  int k = bimatrix.NumCols();
 
   Matrix<T> A(1,k+1,1,m+1);
   Vector<T> b(1,k+1);
   Vector<T> c(1,m+1);
-  PureStrategyProfile profile = p_game->NewPureStrategyProfile();
 
-  Rational minpay = p_game->GetMinPayoff() - Rational(1);
+  Rational minpay = bimatrix.GetMinPayoff() - Rational(1);
 
+  // A(i, j) = minpay - payoff(1) for strategy j of player 1 and i of player 2
+  bimatrix.GetScaledPayoffs(1, minpay, Rational(-1), A, 0, 0, true);
   for (int i = 1; i <= k; i++)  {
-    profile->SetStrategy(p_game->Players()[2]->Strategies()[i]);
-    for (int j = 1; j <= m; j++)  {
-      profile->SetStrategy(p_game->Players()[1]->Strategies()[j]);
-      A(i, j) = minpay - profile->GetPayoff(1);
-    }
     A(i,m+1) = (T) 1;
   }
   for (int j = 1; j <= m; j++) {
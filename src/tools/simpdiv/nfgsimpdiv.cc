@@ -92,6 +92,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
   std::cerr << "  -n COUNT         number of starting points to generate (requires -r)\n";
   std::cerr << "  -s FILE          file containing starting points\n";
+  std::cerr << "  -E               eliminate strategies strictly dominated by mixed\n";
+  std::cerr << "                   strategies first\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -105,7 +107,7 @@ int main(int argc, char *argv[])
   std::string startFile;
   bool useRandom = false;
   int randDenom = 1, gridResize = 2, stopAfter = 1;
-  bool verbose = false, quiet = false;
+  bool verbose = false, quiet = false, eliminate = false;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -115,7 +117,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qSE", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -143,6 +145,9 @@ int main(int argc, char *argv[])
       break;
     case 'S':
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -174,11 +179,18 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = ReadGame(*input_stream), full = game;
+    if (eliminate) {
+      game = UndominatedRestriction(game);
+    }
     List<MixedStrategyProfile<Rational> > starts;
     if (startFile != "") {
+      // Starting points are given on the game as read
       std::ifstream startPoints(startFile.c_str());
-      starts = ReadProfiles(game, startPoints);
+      starts = ReadProfiles(full, startPoints);
+      for (int i = 1; i <= starts.size(); i++) {
+	starts[i] = starts[i].Restrict(game);
+      }
     }
     else if (useRandom) {
       starts = RandomProfiles(game, stopAfter, randDenom);
@@ -193,6 +205,9 @@ int main(int argc, char *argv[])
     for (int i = 1; i <= starts.size(); i++) {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (eliminate) {
+	renderer = new RestrictedStrategyRenderer<Rational>(renderer);
+      }
       NashSimpdivStrategySolver algorithm(gridResize, 0, verbose,
 					  renderer);
       algorithm.Solve(starts[i]);